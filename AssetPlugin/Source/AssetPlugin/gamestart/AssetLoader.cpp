@@ -292,6 +292,12 @@ void AssetLoader::loadMaterials(){
             loadMaterial(TEXT("Material'/Game/Prefabs/terrain/materials/wingMaterial.wingMaterial'"))
         );
 
+        //foliage impostor, masked, samples the texture parameter "ImpostorAtlas"
+        a->addMaterial(
+            materialEnum::impostorMaterial,
+            loadMaterial(TEXT("Material'/Game/Prefabs/terrain/materials/impostorMaterial.impostorMaterial'"))
+        );
+
 
 
 
@@ -18,5 +18,6 @@ enum class materialEnum
     snowMaterial,
     prop_alarmBoxMaterial,
     _texturedMaterial,
-    wingMaterial
+    wingMaterial,
+    impostorMaterial
 };
\ No newline at end of file
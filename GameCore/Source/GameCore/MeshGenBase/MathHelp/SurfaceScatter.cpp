@@ -0,0 +1,164 @@
+
+#include "CoreMinimal.h"
+#include "SurfaceScatter.h"
+
+SurfaceScatter::SurfaceScatter(){
+
+}
+
+SurfaceScatter::~SurfaceScatter(){
+    clear();
+}
+
+void SurfaceScatter::clear(){
+    count = 0;
+}
+
+int SurfaceScatter::num(){
+    return count;
+}
+
+/// @brief resizes all buffers, the content is overwritten by the build pass
+void SurfaceScatter::allocate(int frames){
+    count = frames;
+    px.SetNumUninitialized(frames);
+    py.SetNumUninitialized(frames);
+    pz.SetNumUninitialized(frames);
+    nx.SetNumUninitialized(frames);
+    ny.SetNumUninitialized(frames);
+    nz.SetNumUninitialized(frames);
+    rx.SetNumUninitialized(frames);
+    ry.SetNumUninitialized(frames);
+    ux.SetNumUninitialized(frames);
+    uy.SetNumUninitialized(frames);
+    uz.SetNumUninitialized(frames);
+}
+
+
+/**
+ *
+ * --- frames ---
+ *
+ */
+
+/// @brief one frame per triangle at the triangle center, all triangles included
+/// @param surface mesh to scatter on
+void SurfaceScatter::buildFaceFrames(MeshData &surface){
+    TArray<FVector> &vertecies = surface.getVerteciesRef();
+    TArray<int32> &triangles = surface.getTrianglesRef();
+
+    allocate(triangles.Num() / 3);
+    int frame = 0;
+    for (int i = 0; i + 2 < triangles.Num(); i += 3){
+        int32 v0 = triangles[i];
+        int32 v1 = triangles[i + 1];
+        int32 v2 = triangles[i + 2];
+        if(!vertecies.IsValidIndex(v0) || !vertecies.IsValidIndex(v1) || !vertecies.IsValidIndex(v2)){
+            continue;
+        }
+        FVector &a = vertecies[v0];
+        FVector &b = vertecies[v1];
+        FVector &c = vertecies[v2];
+
+        FVector normal = FVector::CrossProduct(b - a, c - a).GetSafeNormal();
+        FVector center = (a + b + c) / 3.0f;
+        setFrame(frame, center, normal);
+        frame++;
+    }
+    count = frame;
+}
+
+void SurfaceScatter::setFrame(int frame, FVector &position, FVector &normal){
+    px[frame] = position.X;
+    py[frame] = position.Y;
+    pz[frame] = position.Z;
+    setBasis(frame, normal);
+}
+
+/// @brief yaw and pitch basis without trigonometry: the yaw rotated y axis is
+/// (-n.y, n.x, 0) normalized, pitch does not change it
+void SurfaceScatter::setBasis(int frame, FVector &normal){
+    FVector right(-normal.Y, normal.X, 0.0f);
+    float length = right.Size();
+    if(length < 0.0001f){
+        right = FVector(0, 1, 0); //normal is vertical, no yaw
+    }else{
+        right /= length;
+    }
+    FVector up = FVector::CrossProduct(normal, right);
+
+    nx[frame] = normal.X;
+    ny[frame] = normal.Y;
+    nz[frame] = normal.Z;
+    rx[frame] = right.X;
+    ry[frame] = right.Y;
+    ux[frame] = up.X;
+    uy[frame] = up.Y;
+    uz[frame] = up.Z;
+}
+
+
+/**
+ *
+ * --- instancing ---
+ *
+ */
+
+/// @brief appends one copy of the template per frame with a single append, the
+/// buffers are sized once. Normals are rotated with the frame basis
+/// @param templateMesh mesh oriented along the x axis, pivot at 0
+/// @param output mesh to append to
+void SurfaceScatter::instanceTemplate(MeshData &templateMesh, MeshData &output){
+    TArray<FVector> &templateVertecies = templateMesh.getVerteciesRef();
+    TArray<int32> &templateTriangles = templateMesh.getTrianglesRef();
+    TArray<FVector> &templateNormals = templateMesh.getNormalsRef();
+    int vertexCount = templateVertecies.Num();
+    int triangleCount = templateTriangles.Num();
+    if(count == 0 || vertexCount == 0){
+        return;
+    }
+    bool hasNormals = templateNormals.Num() == vertexCount;
+
+    TArray<FVector> vertecies;
+    TArray<int32> triangles;
+    vertecies.SetNumUninitialized(count * vertexCount);
+    triangles.SetNumUninitialized(count * triangleCount);
+
+    MeshData batch;
+    TArray<FVector> &normals = batch.getNormalsRef();
+    if(hasNormals){
+        normals.SetNumUninitialized(count * vertexCount);
+    }
+
+    for (int f = 0; f < count; f++){
+        int vertexOffset = f * vertexCount;
+        for (int v = 0; v < vertexCount; v++){
+            FVector &local = templateVertecies[v];
+            vertecies[vertexOffset + v] = FVector(
+                px[f] + local.X * nx[f] + local.Y * rx[f] + local.Z * ux[f],
+                py[f] + local.X * ny[f] + local.Y * ry[f] + local.Z * uy[f],
+                pz[f] + local.X * nz[f] + local.Z * uz[f]
+            );
+        }
+        if(hasNormals){
+            //orthonormal basis: the rotation is its own normal matrix
+            for (int v = 0; v < vertexCount; v++){
+                FVector &local = templateNormals[v];
+                normals[vertexOffset + v] = FVector(
+                    local.X * nx[f] + local.Y * rx[f] + local.Z * ux[f],
+                    local.X * ny[f] + local.Y * ry[f] + local.Z * uy[f],
+                    local.X * nz[f] + local.Z * uz[f]
+                );
+            }
+        }
+
+        int triangleOffset = f * triangleCount;
+        for (int t = 0; t < triangleCount; t++){
+            triangles[triangleOffset + t] = templateTriangles[t] + vertexOffset;
+        }
+    }
+
+    batch.setVertecies(MoveTemp(vertecies));
+    batch.setTriangles(MoveTemp(triangles));
+    output.append(batch);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "GameCore/MeshGenBase/MeshData/MeshData.h"
+
+/**
+ * batched surface scatter: creates one frame (position and orthonormal basis) per face
+ * in one pass into preallocated, 16 byte aligned structure of arrays buffers, then instances a template mesh on all frames at once.
+ *
+ * The basis matches MMatrix::createRotatorFrom(normal) (yaw and pitch, no roll):
+ * X is the normal, Y stays horizontal, Z = X x Y. Orient the template along X.
+ */
+class GAMECORE_API SurfaceScatter{
+
+public:
+    SurfaceScatter();
+    ~SurfaceScatter();
+
+    void clear();
+
+    void buildFaceFrames(MeshData &surface);
+
+    int num();
+
+    void instanceTemplate(MeshData &templateMesh, MeshData &output);
+
+private:
+    int count = 0;
+
+    //position
+    TArray<float, TAlignedHeapAllocator<16>> px;
+    TArray<float, TAlignedHeapAllocator<16>> py;
+    TArray<float, TAlignedHeapAllocator<16>> pz;
+
+    //x axis (normal)
+    TArray<float, TAlignedHeapAllocator<16>> nx;
+    TArray<float, TAlignedHeapAllocator<16>> ny;
+    TArray<float, TAlignedHeapAllocator<16>> nz;
+
+    //y axis, always horizontal (z = 0)
+    TArray<float, TAlignedHeapAllocator<16>> rx;
+    TArray<float, TAlignedHeapAllocator<16>> ry;
+
+    //z axis
+    TArray<float, TAlignedHeapAllocator<16>> ux;
+    TArray<float, TAlignedHeapAllocator<16>> uy;
+    TArray<float, TAlignedHeapAllocator<16>> uz;
+
+    void allocate(int frames);
+    void setBasis(int frame, FVector &normal);
+    void setFrame(int frame, FVector &position, FVector &normal);
+};
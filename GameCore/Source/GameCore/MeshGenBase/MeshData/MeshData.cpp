@@ -654,7 +654,7 @@ void MeshData::appendEfficent(
 void MeshData::appendEfficent(MeshData &other){
 
     TArray<int32> &trianglesRef = other.getTrianglesRef();
-    for (int i = 0; i < trianglesRef.Num() - 3; i += 3){ //-2 ? (no, -3 is correct)
+    for (int i = 0; i + 2 < trianglesRef.Num(); i += 3){ //last triangle included
         int32 v0 = trianglesRef[i];
         int32 v1 = trianglesRef[i + 1];
         int32 v2 = trianglesRef[i + 2];
@@ -1418,7 +1418,7 @@ void MeshData::setTargetMaterial(materialEnum inMaterial){
 void MeshData::generateMatricesPerFaceAndLookDirOfNormal(
     std::vector<MMatrix> &output
 ){
-    for (int i = 0; i < triangles.Num() - 3; i+= 3){
+    for (int i = 0; i + 2 < triangles.Num(); i+= 3){
         int v0 = triangles[i];
         int v1 = triangles[i+1];
         int v2 = triangles[i+2];
@@ -1464,7 +1464,7 @@ void MeshData::generateMatricesPerFaceAndLookDirOfNormalInterpolated(
 
 
     baryCentricInterpolator interpolator;
-    for (int i = 0; i < triangles.Num() - 3; i+= 3){
+    for (int i = 0; i + 2 < triangles.Num(); i+= 3){
         int v0 = triangles[i];
         int v1 = triangles[i+1];
         int v2 = triangles[i+2];
@@ -0,0 +1,201 @@
+
+#include "CoreMinimal.h"
+#include "CollisionProxyBuilder.h"
+
+CollisionProxyBuilder::CollisionProxyBuilder(){
+
+}
+
+CollisionProxyBuilder::~CollisionProxyBuilder(){
+    clear();
+}
+
+void CollisionProxyBuilder::clear(){
+    vertecies.Empty();
+    triangles.Empty();
+}
+
+bool CollisionProxyBuilder::hasAnyVertecies(){
+    return vertecies.Num() > 0;
+}
+
+int CollisionProxyBuilder::verteciesNum(){
+    return vertecies.Num();
+}
+
+int CollisionProxyBuilder::trianglesNum(){
+    return triangles.Num() / 3;
+}
+
+TArray<FVector> &CollisionProxyBuilder::getVerteciesRef(){
+    return vertecies;
+}
+
+TArray<int32> &CollisionProxyBuilder::getTrianglesRef(){
+    return triangles;
+}
+
+
+/**
+ *
+ * --- heightfield ---
+ *
+ */
+
+/// @brief appends a coarse heightfield sampled every stepSize nodes of the map,
+/// the last row and column are always included so chunk borders stay closed
+/// @param map 2D vector of LOCAL coordinates, same as the render terrain
+/// @param stepSize index step between samples, 1 would be full resolution
+void CollisionProxyBuilder::appendHeightfield(
+    std::vector<std::vector<FVector>> &map,
+    int stepSize
+){
+    if(map.size() < 2 || map[0].size() < 2){
+        return;
+    }
+
+    std::vector<int> xIndices;
+    std::vector<int> yIndices;
+    buildSampleIndices(map.size(), stepSize, xIndices);
+    buildSampleIndices(map[0].size(), stepSize, yIndices);
+
+    int sizeX = xIndices.size();
+    int sizeY = yIndices.size();
+    int offset = vertecies.Num();
+
+    vertecies.Reserve(offset + sizeX * sizeY);
+    triangles.Reserve(triangles.Num() + (sizeX - 1) * (sizeY - 1) * 6);
+
+    for (int i = 0; i < sizeX; i++){
+        std::vector<FVector> &column = map[xIndices[i]];
+        for (int j = 0; j < sizeY; j++){
+            int y = std::min(yIndices[j], (int)column.size() - 1);
+            vertecies.Add(column[y]);
+        }
+    }
+
+    //same winding as the render terrain
+    //    1--2
+    //    |  |
+    //    0<-3
+    for (int i = 0; i < sizeX - 1; i++){
+        for (int j = 0; j < sizeY - 1; j++){
+            int v0 = offset + i * sizeY + j;
+            int v1 = offset + i * sizeY + (j + 1);
+            int v2 = offset + (i + 1) * sizeY + (j + 1);
+            int v3 = offset + (i + 1) * sizeY + j;
+            addQuad(v0, v1, v2, v3);
+        }
+    }
+}
+
+/// @brief creates the sample indices 0, step, 2*step ... size-1
+void CollisionProxyBuilder::buildSampleIndices(int size, int stepSize, std::vector<int> &output){
+    if(stepSize < 1){
+        stepSize = 1;
+    }
+    for (int i = 0; i < size - 1; i += stepSize){
+        output.push_back(i);
+    }
+    output.push_back(size - 1);
+}
+
+
+/**
+ *
+ * --- simple proxies ---
+ *
+ */
+
+/// @brief appends an axis aligned box standing on the bottom center
+/// @param bottomCenter local position, for example a tree root
+/// @param halfWidth half extent on x and y
+/// @param height extent on z
+void CollisionProxyBuilder::appendBoxProxy(
+    FVector &bottomCenter,
+    float halfWidth,
+    float height
+){
+    FVector min = bottomCenter - FVector(halfWidth, halfWidth, 0);
+    FVector max = bottomCenter + FVector(halfWidth, halfWidth, height);
+    appendBox(min, max);
+}
+
+/// @brief appends a box around the given vertecies, the width on x and y is clamped
+/// around the center so wide tree crowns dont block the way, only the stem does
+/// @param verteciesIn vertecies to enclose (for example a rock or tree stem)
+/// @param offset offset added to all vertecies
+/// @param maxHalfWidth max half extent on x and y, ignored if <= 0
+void CollisionProxyBuilder::appendBoundsProxy(
+    TArray<FVector> &verteciesIn,
+    FVector &offset,
+    float maxHalfWidth
+){
+    if(verteciesIn.Num() == 0){
+        return;
+    }
+
+    FVector min = verteciesIn[0];
+    FVector max = verteciesIn[0];
+    for (int i = 1; i < verteciesIn.Num(); i++){
+        FVector &current = verteciesIn[i];
+        min = min.ComponentMin(current);
+        max = max.ComponentMax(current);
+    }
+
+    if(maxHalfWidth > 0.0f){
+        FVector center = (min + max) / 2.0f;
+        min.X = std::max(min.X, center.X - maxHalfWidth);
+        min.Y = std::max(min.Y, center.Y - maxHalfWidth);
+        max.X = std::min(max.X, center.X + maxHalfWidth);
+        max.Y = std::min(max.Y, center.Y + maxHalfWidth);
+    }
+
+    min += offset;
+    max += offset;
+    appendBox(min, max);
+}
+
+void CollisionProxyBuilder::appendBox(FVector &min, FVector &max){
+    /*
+    1->2
+    |  |
+    0<-3
+    */
+    int offset = vertecies.Num();
+    vertecies.Add(FVector(min.X, min.Y, min.Z)); //a
+    vertecies.Add(FVector(min.X, max.Y, min.Z)); //b
+    vertecies.Add(FVector(max.X, max.Y, min.Z)); //c
+    vertecies.Add(FVector(max.X, min.Y, min.Z)); //d
+    vertecies.Add(FVector(min.X, min.Y, max.Z)); //a1
+    vertecies.Add(FVector(min.X, max.Y, max.Z)); //b1
+    vertecies.Add(FVector(max.X, max.Y, max.Z)); //c1
+    vertecies.Add(FVector(max.X, min.Y, max.Z)); //d1
+
+    int a = offset;
+    int b = offset + 1;
+    int c = offset + 2;
+    int d = offset + 3;
+    int a1 = offset + 4;
+    int b1 = offset + 5;
+    int c1 = offset + 6;
+    int d1 = offset + 7;
+
+    //same order as MeshData::appendCube
+    addQuad(a, d, c, b);
+    addQuad(a1, b1, c1, d1);
+    addQuad(b, b1, a1, a);
+    addQuad(c, c1, b1, b);
+    addQuad(d, d1, c1, c);
+    addQuad(a, a1, d1, d);
+}
+
+void CollisionProxyBuilder::addQuad(int v0, int v1, int v2, int v3){
+    triangles.Add(v0);
+    triangles.Add(v1);
+    triangles.Add(v2);
+
+    triangles.Add(v0);
+    triangles.Add(v2);
+    triangles.Add(v3);
+}
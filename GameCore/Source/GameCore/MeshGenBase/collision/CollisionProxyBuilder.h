@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <vector>
+
+/**
+ * builds a low resolution collision mesh which is decoupled from the render mesh.
+ * The terrain is sampled as a coarse heightfield, trees and rocks are added as simple
+ * box proxies. The buffers are only used for cooking, never rendered.
+ */
+class GAMECORE_API CollisionProxyBuilder{
+
+public:
+    CollisionProxyBuilder();
+    ~CollisionProxyBuilder();
+
+    void clear();
+
+    void appendHeightfield(
+        std::vector<std::vector<FVector>> &map,
+        int stepSize
+    );
+
+    void appendBoxProxy(
+        FVector &bottomCenter,
+        float halfWidth,
+        float height
+    );
+
+    void appendBoundsProxy(
+        TArray<FVector> &verteciesIn,
+        FVector &offset,
+        float maxHalfWidth
+    );
+
+    bool hasAnyVertecies();
+    int verteciesNum();
+    int trianglesNum();
+
+    TArray<FVector> &getVerteciesRef();
+    TArray<int32> &getTrianglesRef();
+
+private:
+    TArray<FVector> vertecies;
+    TArray<int32> triangles;
+
+    void appendBox(FVector &min, FVector &max);
+    void addQuad(int v0, int v1, int v2, int v3);
+
+    static void buildSampleIndices(int size, int stepSize, std::vector<int> &output);
+};
@@ -30,6 +30,13 @@ AcustomMeshActorBase::AcustomMeshActorBase()
     // Attach it to the RootComponent (Mesh) so it has the same transform
     MeshNoRaycast->SetupAttachment(RootComponent);
 
+    //collision only, cooked async and never rendered
+    MeshCollisionProxy = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("collisionProxyMesh"));
+    MeshCollisionProxy->bUseAsyncCooking = true;
+    MeshCollisionProxy->SetVisibility(false);
+    MeshCollisionProxy->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    MeshCollisionProxy->SetupAttachment(RootComponent);
+
     currentLodLevel = ELod::lodNear;
 }
 
@@ -105,6 +112,11 @@ void AcustomMeshActorBase::createTerrainFrom2DMap(
 ){
     thisTerrainType = typeIn;
 
+    //low res physics mesh, render layers wont cook collision anymore
+    enableCollisionProxy();
+    collisionProxy.clear();
+    collisionProxy.appendHeightfield(map, COLLISION_PROXY_STEP);
+
     int distanceBetweenNodesMin = 300;
     //MeshData &grassLayer = findMeshDataReference(materialEnum::grassMaterial, ELod::lodNear, true);
     //MeshData &stoneLayer = findMeshDataReference(materialEnum::stoneMaterial, ELod::lodNear, true);
@@ -152,6 +164,7 @@ void AcustomMeshActorBase::createTerrainFrom2DMap(
 
 
     ReloadMeshAndApplyAllMaterials();
+    applyCollisionProxy();
 
     enableLodListening();
 }
@@ -447,6 +460,9 @@ void AcustomMeshActorBase::updateMesh(
         Tangents, 
         true
     );*/
+    //cooking is skipped if the collision comes from the proxy mesh
+    bool createCollision = !collisionProxyEnabled;
+
     //meshcomponent.ClearMeshSection(layer);
     meshcomponent.CreateMeshSection(
         layer, 
@@ -456,7 +472,7 @@ void AcustomMeshActorBase::updateMesh(
         otherMesh.getUV0Ref(),//UV0, 
         otherMesh.getVertexColorsRef(),//VertexColors, 
         otherMesh.getTangentsRef(),//Tangents, 
-        true
+        createCollision
     );
 
     
@@ -486,6 +502,51 @@ void AcustomMeshActorBase::updateMesh(
 }
 
 
+/**
+ * 
+ * --- collision proxy ---
+ * 
+ */
+
+/// @brief decouples render and physics mesh: render sections are created without
+/// collision, the physics come from the collision proxy component only
+void AcustomMeshActorBase::enableCollisionProxy(){
+    collisionProxyEnabled = true;
+}
+
+/// @brief uploads the collision proxy, cooking runs async on the proxy component.
+/// can be called again after appending more proxies (for example trees)
+void AcustomMeshActorBase::applyCollisionProxy(){
+    if(MeshCollisionProxy == nullptr || !collisionProxyEnabled){
+        return;
+    }
+    if(!collisionProxy.hasAnyVertecies()){
+        return;
+    }
+
+    //not rendered, no normals, uvs or tangents needed
+    TArray<FVector> normals;
+    TArray<FVector2D> UV0;
+    TArray<FColor> vertexColors;
+    TArray<FProcMeshTangent> tangents;
+
+    MeshCollisionProxy->CreateMeshSection(
+        0,
+        collisionProxy.getVerteciesRef(),
+        collisionProxy.getTrianglesRef(),
+        normals,
+        UV0,
+        vertexColors,
+        tangents,
+        true
+    );
+
+    MeshCollisionProxy->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
+    MeshCollisionProxy->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Block);
+    MeshCollisionProxy->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+}
+
+
 /**
  * 
  * --- helper functions for special meshes: rooms ---
@@ -718,6 +779,24 @@ void AcustomMeshActorBase::applyShaderToVertex(FVector &vertex){
     //keep empty, is virtaul here.
 }
 
+/// @brief runs the batched vertex shader on the mesh data, the rest positions
+/// are copied into the batch once, only the heights are written back
+/// @param data mesh data to shade, must keep its vertex count
+void AcustomMeshActorBase::vertexShaderBatchFor(MeshData &data){
+    TArray<FVector> &vertecies = data.getVerteciesRef();
+    if(!shaderBatch.isLoadedFor(vertecies)){
+        shaderBatch.load(vertecies);
+    }
+    applyShaderToBatch(shaderBatch);
+    shaderBatch.storeHeights(vertecies);
+}
+
+/// @brief apply vertex shader to all vertecies of the batch, run a kernel here
+/// @param batch batch to modify
+void AcustomMeshActorBase::applyShaderToBatch(VertexBatch &batch){
+    //keep empty, is virtual here.
+}
+
 void AcustomMeshActorBase::refreshMesh(
     UProceduralMeshComponent& meshComponent,
     MeshData &other,
@@ -10,6 +10,8 @@
 #include "ELod.h"
 #include "GameCore/util/FVectorTouple.h"
 #include "GameCore/MeshGenBase/foliage/ETerrainType.h"
+#include "GameCore/MeshGenBase/collision/CollisionProxyBuilder.h"
+#include "GameCore/MeshGenBase/shader/VertexBatch.h"
 #include "customMeshActorBase.generated.h"
 
 UCLASS()
@@ -136,6 +138,20 @@ protected:
 	UPROPERTY(VisibleAnywhere)
 	class UProceduralMeshComponent *MeshNoRaycast;
 
+	/// @brief hidden component only used for physics, render sections wont cook
+	/// collision while the proxy is enabled
+	UPROPERTY(VisibleAnywhere)
+	class UProceduralMeshComponent *MeshCollisionProxy;
+
+	/// @brief index step of the terrain map for the collision heightfield
+	static const int COLLISION_PROXY_STEP = 2;
+
+	bool collisionProxyEnabled = false;
+	CollisionProxyBuilder collisionProxy;
+
+	void enableCollisionProxy();
+	void applyCollisionProxy();
+
 	//new!
 	std::map<int, MeshDataLod> meshLayersLodMap;
 	std::map<int, MeshDataLod> meshLayersLodMapNoRaycast;
@@ -182,6 +198,11 @@ protected:
 	void vertexShaderFor(MeshData &data);
 	virtual void applyShaderToVertex(FVector &vertex);
 
+	///batched vertex shader, one virtual call per mesh instead of per vertex
+	VertexBatch shaderBatch;
+	void vertexShaderBatchFor(MeshData &data);
+	virtual void applyShaderToBatch(VertexBatch &batch);
+
 	int maxDistanceForLod(ELod lodLevel);
 
 
@@ -0,0 +1,73 @@
+
+#include "CoreMinimal.h"
+#include "VertexBatch.h"
+#include <algorithm>
+
+VertexBatch::VertexBatch(){
+
+}
+
+VertexBatch::~VertexBatch(){
+
+}
+
+/// @brief copies the vertecies into the aligned arrays, padding is filled with 0
+/// @param vertecies vertecies to copy, local space
+void VertexBatch::load(TArray<FVector> &vertecies){
+    load(vertecies, 0, vertecies.Num());
+}
+
+/// @brief copies a range of the vertecies, storeHeights writes back to the same range
+/// @param vertecies vertecies to copy from, local space
+/// @param start first vertex of the range
+/// @param num vertecies in the range, clamped to the buffer
+void VertexBatch::load(TArray<FVector> &vertecies, int start, int num){
+    offset = std::max(0, std::min(start, vertecies.Num()));
+    count = std::max(0, std::min(num, vertecies.Num() - offset));
+    paddedCount = ((count + LANES - 1) / LANES) * LANES;
+
+    xs.SetNumZeroed(paddedCount);
+    ys.SetNumZeroed(paddedCount);
+    zs.SetNumZeroed(paddedCount);
+
+    for (int i = 0; i < count; i++){
+        FVector &current = vertecies[offset + i];
+        xs[i] = current.X;
+        ys[i] = current.Y;
+        zs[i] = current.Z;
+    }
+}
+
+/// @brief writes the heights back, x and y of the vertecies stay untouched
+/// @param vertecies same buffer as loaded
+void VertexBatch::storeHeights(TArray<FVector> &vertecies){
+    int limit = std::min(count, vertecies.Num() - offset);
+    for (int i = 0; i < limit; i++){
+        vertecies[offset + i].Z = zs[i];
+    }
+}
+
+/// @brief returns if the batch was loaded for the whole buffer of this size
+bool VertexBatch::isLoadedFor(TArray<FVector> &vertecies){
+    return count > 0 && offset == 0 && count == vertecies.Num();
+}
+
+int VertexBatch::num(){
+    return count;
+}
+
+int VertexBatch::paddedNum(){
+    return paddedCount;
+}
+
+const float *VertexBatch::xData(){
+    return xs.GetData();
+}
+
+const float *VertexBatch::yData(){
+    return ys.GetData();
+}
+
+float *VertexBatch::zData(){
+    return zs.GetData();
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ContainerAllocationPolicies.h"
+
+/**
+ * structure of arrays copy of a vertex buffer for the cpu vertex shader.
+ * x and y are the rest positions and loaded once, the kernel writes the heights (z).
+ * All arrays are 16 byte aligned and padded to a multiple of 4 so a kernel
+ * can process 4 vertecies per simd register without a scalar tail.
+ *
+ * A kernel is any type with
+ * void process(const float *xs, const float *ys, float *zs, int count);
+ * it is called once per batch, not once per vertex.
+ */
+class GAMECORE_API VertexBatch{
+
+public:
+    VertexBatch();
+    ~VertexBatch();
+
+    static const int LANES = 4;
+
+    void load(TArray<FVector> &vertecies);
+    void load(TArray<FVector> &vertecies, int start, int num);
+    void storeHeights(TArray<FVector> &vertecies);
+
+    bool isLoadedFor(TArray<FVector> &vertecies);
+
+    int num();
+    int paddedNum();
+
+    const float *xData();
+    const float *yData();
+    float *zData();
+
+    template <typename TKernel>
+    void run(TKernel &kernel){
+        if(count > 0){
+            kernel.process(xs.GetData(), ys.GetData(), zs.GetData(), paddedCount);
+        }
+    }
+
+private:
+    int offset = 0;
+    int count = 0;
+    int paddedCount = 0;
+
+    TArray<float, TAlignedHeapAllocator<16>> xs;
+    TArray<float, TAlignedHeapAllocator<16>> ys;
+    TArray<float, TAlignedHeapAllocator<16>> zs;
+};
@@ -0,0 +1,146 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "terrainPlugin/meshgen/foliage/helper/GeometryUtil.h"
+#include "terrainPlugin/meshgen/foliage/helper/GrahamScan.h"
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace{
+    void randomPoints(int count, int32 seed, std::vector<FVector> &output){
+        FRandomStream random(seed);
+        output.clear();
+        for (int i = 0; i < count; i++){
+            output.push_back(FVector(
+                random.FRandRange(-10000.0f, 10000.0f),
+                random.FRandRange(-10000.0f, 10000.0f),
+                random.FRandRange(-100.0f, 100.0f)
+            ));
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGeometryUtilOrderLineTest,
+    "terrainPlugin.Foliage.GeometryUtil.OrderPointsOnLine",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+/// 40 points on the x axis 100 apart, shuffled by x = (7 * i mod 40) * 100,
+/// starting at x = 0 the nearest unused point is always the next one to the right.
+/// 40 is above the linear limit, so the grid path is used
+bool FGeometryUtilOrderLineTest::RunTest(const FString &Parameters){
+    const int count = 40;
+    std::vector<FVector> points;
+    for (int i = 0; i < count; i++){
+        points.push_back(FVector(((7 * i) % count) * 100.0f, 0, 0));
+    }
+
+    GeometryUtil::orderByNearestNeighbour(MakeArrayView(points.data(), points.size()), 0);
+
+    TestEqual(TEXT("point count"), (int)points.size(), count);
+    for (int i = 0; i < points.size(); i++){
+        if(!TestEqual(FString::Printf(TEXT("x of point %d"), i), points[i].X, i * 100.0)){
+            break;
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGeometryUtilOrderReferenceTest,
+    "terrainPlugin.Foliage.GeometryUtil.OrderMatchesLinear",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+/// grid ordering against the linear scan on random sets, ties resolve the same way
+bool FGeometryUtilOrderReferenceTest::RunTest(const FString &Parameters){
+    std::vector<int> counts = {16, 2000};
+    for (int c = 0; c < counts.size(); c++){
+        std::vector<FVector> linear;
+        randomPoints(counts[c], 42 + c, linear);
+        std::vector<FVector> grid = linear;
+
+        GeometryUtil::orderByNearestNeighbourLinear(MakeArrayView(linear.data(), linear.size()), 0);
+        GeometryUtil::orderByNearestNeighbour(MakeArrayView(grid.data(), grid.size()), 0);
+
+        for (int i = 0; i < grid.size(); i++){
+            FString what = FString::Printf(TEXT("%d points, point %d"), counts[c], i);
+            if(!TestEqual(what, grid[i], linear[i], 0.0f)){
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGeometryUtilHullSquareTest,
+    "terrainPlugin.Foliage.GeometryUtil.HullOfSquare",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+/// square with its center and an edge midpoint: only the 4 corners are on the hull,
+/// collinear points are dropped, clockwise starting at the smallest x
+bool FGeometryUtilHullSquareTest::RunTest(const FString &Parameters){
+    std::vector<FVector> points = {
+        FVector(50, 50, 0),
+        FVector(0, 0, 0),
+        FVector(100, 0, 0),
+        FVector(100, 100, 0),
+        FVector(0, 100, 0),
+        FVector(50, 0, 0)
+    };
+    std::vector<int> hull;
+    int count = GeometryUtil::convexHullXY(MakeArrayView(points.data(), points.size()), hull);
+
+    TestEqual(TEXT("hull count"), count, 4);
+    std::vector<int> expected = {1, 4, 3, 2};
+    if(TestEqual(TEXT("hull indices"), (int)hull.size(), (int)expected.size())){
+        for (int i = 0; i < expected.size(); i++){
+            TestEqual(FString::Printf(TEXT("hull index %d"), i), hull[i], expected[i]);
+        }
+    }
+
+    std::vector<int> tooFew;
+    TestEqual(TEXT("2 points have no hull"), GeometryUtil::convexHullXY(MakeArrayView(points.data(), 2), tooFew), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGeometryUtilHullReferenceTest,
+    "terrainPlugin.Foliage.GeometryUtil.HullMatchesGrahamScan",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+/// index hull against GrahamScan on random sets, same winding and start point
+bool FGeometryUtilHullReferenceTest::RunTest(const FString &Parameters){
+    std::vector<int> counts = {16, 2000};
+    for (int c = 0; c < counts.size(); c++){
+        std::vector<FVector> input;
+        randomPoints(counts[c], 7 + c, input);
+
+        std::vector<FVector> scanned = input;
+        GrahamScan scan;
+        scan.ComputeConvexHull(scanned);
+
+        std::vector<int> hull;
+        GeometryUtil::convexHullXY(MakeArrayView(input.data(), input.size()), hull);
+
+        FString what = FString::Printf(TEXT("%d points"), counts[c]);
+        if(!TestEqual(what + TEXT(" hull count"), (int)hull.size(), (int)scanned.size())){
+            continue;
+        }
+        for (int i = 0; i < hull.size(); i++){
+            if(!TestEqual(what + FString::Printf(TEXT(" hull point %d"), i), input[hull[i]], scanned[i], 0.0f)){
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+#endif
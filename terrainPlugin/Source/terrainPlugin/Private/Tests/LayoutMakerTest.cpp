@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "GameCore/util/TTouple.h"
+#include "terrainPlugin/meshgen/rooms/layoutCreator/layoutMaker.h"
+#include "terrainPlugin/meshgen/rooms/roomActor/roomBoundData.h"
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace{
+    /// @brief every room lies in the usable field (the last row and column stay free)
+    /// and no cell is covered twice
+    /// @return covered cells
+    int testRoomsInBoundsAndDisjoint(
+        FAutomationTestBase &test,
+        int xMeters,
+        int yMeters,
+        std::vector<roomBoundData> &rooms
+    ){
+        std::vector<std::vector<int>> covered(xMeters, std::vector<int>(yMeters, 0));
+        int area = 0;
+        for (int r = 0; r < rooms.size(); r++){
+            roomBoundData &room = rooms[r];
+            int toX = room.xpos() + room.xScale();
+            int toY = room.ypos() + room.yScale();
+            FString what = FString::Printf(TEXT("room %d"), r);
+            bool inBounds = room.xpos() >= 0 && room.ypos() >= 0 &&
+                room.xScale() > 0 && room.yScale() > 0 &&
+                toX <= xMeters - 1 && toY <= yMeters - 1;
+            if(!test.TestTrue(what + TEXT(" inside the field"), inBounds)){
+                continue;
+            }
+            for (int i = room.xpos(); i < toX; i++){
+                for (int j = room.ypos(); j < toY; j++){
+                    covered[i][j]++;
+                    test.TestEqual(
+                        what + FString::Printf(TEXT(" cell %d %d covered once"), i, j),
+                        covered[i][j],
+                        1
+                    );
+                }
+            }
+            area += room.xScale() * room.yScale();
+        }
+        return area;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FLayoutMakerExactFitTest,
+    "terrainPlugin.Rooms.LayoutMaker.ExactFit",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+/// 13 x 13 leaves 12 x 12 usable, which only 6 x 6 rooms are asked for:
+/// exactly 4 rooms of 6 x 6 fill it without any leftover room
+bool FLayoutMakerExactFitTest::RunTest(const FString &Parameters){
+    std::vector<TTouple<int, int>> sizes;
+    sizes.push_back(TTouple<int, int>(6, 6));
+
+    layoutMaker maker;
+    std::vector<roomBoundData> rooms;
+    maker.makeLayout(13, 13, sizes, rooms);
+
+    TestEqual(TEXT("room count"), (int)rooms.size(), 4);
+    for (int r = 0; r < rooms.size(); r++){
+        TestEqual(FString::Printf(TEXT("room %d x scale"), r), rooms[r].xScale(), 6);
+        TestEqual(FString::Printf(TEXT("room %d y scale"), r), rooms[r].yScale(), 6);
+    }
+    TestEqual(TEXT("covered area"), testRoomsInBoundsAndDisjoint(*this, 13, 13, rooms), 144);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FLayoutMakerBuildingTest,
+    "terrainPlugin.Rooms.LayoutMaker.BuildingLayouts",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+/// footprints with the size set of BuildingGenerationJob: rooms exist, stay inside and
+/// do not overlap, the same seed gives the same layout
+bool FLayoutMakerBuildingTest::RunTest(const FString &Parameters){
+    std::vector<TTouple<int, int>> footprints;
+    footprints.push_back(TTouple<int, int>(12, 12));
+    footprints.push_back(TTouple<int, int>(30, 18));
+
+    for (int f = 0; f < footprints.size(); f++){
+        int xMeters = footprints[f].first();
+        int yMeters = footprints[f].last();
+        std::vector<TTouple<int, int>> sizes;
+        sizes.push_back(TTouple<int, int>(xMeters / 2, yMeters / 2));
+        sizes.push_back(TTouple<int, int>(xMeters / 3, yMeters / 3));
+        sizes.push_back(TTouple<int, int>(xMeters / 4, yMeters / 4));
+
+        FString what = FString::Printf(TEXT("%d x %d"), xMeters, yMeters);
+
+        layoutMaker maker;
+        maker.setRandomSeed(42);
+        std::vector<roomBoundData> rooms;
+        maker.makeLayout(xMeters, yMeters, sizes, rooms);
+        TestTrue(what + TEXT(" has rooms"), rooms.size() > 0);
+        testRoomsInBoundsAndDisjoint(*this, xMeters, yMeters, rooms);
+
+        layoutMaker again;
+        again.setRandomSeed(42);
+        std::vector<roomBoundData> roomsAgain;
+        again.makeLayout(xMeters, yMeters, sizes, roomsAgain);
+        if(TestEqual(what + TEXT(" same room count"), (int)roomsAgain.size(), (int)rooms.size())){
+            for (int r = 0; r < rooms.size(); r++){
+                FString room = what + FString::Printf(TEXT(" room %d"), r);
+                TestEqual(room + TEXT(" same x"), roomsAgain[r].xpos(), rooms[r].xpos());
+                TestEqual(room + TEXT(" same y"), roomsAgain[r].ypos(), rooms[r].ypos());
+                TestEqual(room + TEXT(" same x scale"), roomsAgain[r].xScale(), rooms[r].xScale());
+                TestEqual(room + TEXT(" same y scale"), roomsAgain[r].yScale(), rooms[r].yScale());
+            }
+        }
+    }
+    return true;
+}
+
+#endif
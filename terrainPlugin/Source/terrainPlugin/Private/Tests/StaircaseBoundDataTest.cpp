@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "terrainPlugin/meshgen/rooms/roomActor/helper/staircaseBoundData.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace{
+    /// @brief appendDoublesided: 4 triangles with own vertecies per quad
+    const int VERTECIES_PER_QUAD = 12;
+
+    void testQuads(
+        FAutomationTestBase &test,
+        int sizeX,
+        int sizeY,
+        int heightLimit,
+        int expectedQuads
+    ){
+        StaircaseBoundData stairs;
+        stairs.createLayout(sizeX, sizeY);
+        MeshData data = stairs.generate(100, heightLimit, 90);
+
+        FString what = FString::Printf(TEXT("%dx%d up to %d"), sizeX, sizeY, heightLimit);
+        test.TestEqual(what + TEXT(" quads"), stairs.lastQuadCount(), expectedQuads);
+        test.TestEqual(
+            what + TEXT(" vertecies"),
+            data.verteciesNum(),
+            expectedQuads * VERTECIES_PER_QUAD
+        );
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FStaircaseStraightRunTest,
+    "terrainPlugin.Rooms.Staircase.StraightRunMerges",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+/// walk around the border: each side is a flat corner followed by n - 2 slopes in one
+/// direction with the same rise, the slopes lie in one plane and collapse to 1 quad.
+/// 4 sides * (corner + run) + the closing corner (flat after a slope) = 9 quads for
+/// every size, unmerged it would be 4 * (n - 1) + 1 steps. The limit is never reached.
+bool FStaircaseStraightRunTest::RunTest(const FString &Parameters){
+    const int noLimit = 100000;
+    testQuads(*this, 3, 3, noLimit, 9);
+    testQuads(*this, 6, 6, noLimit, 9);
+    testQuads(*this, 10, 10, noLimit, 9); //37 steps
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FStaircaseHeightLimitTest,
+    "terrainPlugin.Rooms.Staircase.HeightLimit",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+/// at 300 the last slope is shortened to the limit (own rise, own quad) and everything
+/// after it turns flat, flat steps in one direction merge as well
+bool FStaircaseHeightLimitTest::RunTest(const FString &Parameters){
+    //4x4: side 1 corner + run, side 2 corner + 90 + 30 rise, side 3 corner + flat run,
+    //side 4 corner, flat run and closing corner in one plane
+    testQuads(*this, 4, 4, 300, 8);
+    testQuads(*this, 3, 6, 300, 8);
+    testQuads(*this, 2, 2, 300, 3);
+    return true;
+}
+
+#endif
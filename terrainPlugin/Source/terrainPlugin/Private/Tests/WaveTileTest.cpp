@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "terrainPlugin/meshgen/water/shader/WaveTile.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * all tests use the shared tile with its default waves:
+ * 10 * sin(x * k + t) + 10 * cos(y * k + t), k = 2 pi * 10 / TILE_LENGTH (640 cm wavelength)
+ */
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FWaveTileAnalyticTest,
+    "terrainPlugin.Water.WaveTile.AnalyticWaves",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+bool FWaveTileAnalyticTest::RunTest(const FString &Parameters){
+    WaveTile *tile = WaveTile::instance();
+    const float tolerance = 0.01f;
+
+    //sin(0) + cos(0), then a quarter wavelength along x: sin(pi / 2) + cos(0)
+    TestEqual(TEXT("height at origin"), tile->evaluateAnalytic(0, 0, 0), 10.0f, tolerance);
+    TestEqual(TEXT("height at a quarter wavelength"), tile->evaluateAnalytic(160, 0, 0), 20.0f, tolerance);
+    TestEqual(TEXT("shortest wavelength"), tile->shortestWavelength(), 640.0f, tolerance);
+
+    //the tile repeats in space and time
+    FRandomStream random(1337);
+    for (int i = 0; i < 16; i++){
+        float x = random.FRandRange(0.0f, WaveTile::TILE_LENGTH);
+        float y = random.FRandRange(0.0f, WaveTile::TILE_LENGTH);
+        float t = random.FRandRange(0.0f, WaveTile::TIME_PERIOD);
+        float h = tile->evaluateAnalytic(x, y, t);
+        TestEqual(TEXT("period along x"), tile->evaluateAnalytic(x + WaveTile::TILE_LENGTH, y, t), h, tolerance);
+        TestEqual(TEXT("period along y"), tile->evaluateAnalytic(x, y + WaveTile::TILE_LENGTH, t), h, tolerance);
+        TestEqual(TEXT("period in time"), tile->evaluateAnalytic(x, y, t + WaveTile::TIME_PERIOD), h, tolerance);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FWaveTileBakeTest,
+    "terrainPlugin.Water.WaveTile.BakedSamples",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+/// every baked sample is the wave sum at its grid position, including the wrapped
+/// neighbours of the last row and column
+bool FWaveTileBakeTest::RunTest(const FString &Parameters){
+    WaveTile *tile = WaveTile::instance();
+    TestTrue(TEXT("baked"), tile->isBaked());
+
+    float step = WaveTile::TILE_LENGTH / WaveTile::RESOLUTION;
+    float frameStep = WaveTile::TIME_PERIOD / WaveTile::TIME_FRAMES;
+    for (int frame = 0; frame < WaveTile::TIME_FRAMES; frame++){
+        for (int x = 0; x <= WaveTile::RESOLUTION; x++){
+            for (int y = 0; y <= WaveTile::RESOLUTION; y++){
+                float expected = tile->evaluateAnalytic(x * step, y * step, frame * frameStep);
+                FString what = FString::Printf(TEXT("frame %d sample %d %d"), frame, x, y);
+                if(!TestEqual(what, tile->bakedHeight(frame, x, y), expected, 0.01f)){
+                    return true;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FWaveTileSampleTest,
+    "terrainPlugin.Water.WaveTile.InterpolatedSamples",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter
+)
+
+/// lookups between samples and frames, also across the seam, stay within the
+/// interpolation error bound. 6.4 samples per wavelength and 32 frames per period:
+/// 2 * 10 * ((2 pi / 6.4)^2 + (2 pi / 32)^2) / 8 = 2.506 cm
+bool FWaveTileSampleTest::RunTest(const FString &Parameters){
+    WaveTile *tile = WaveTile::instance();
+    float bound = tile->interpolationErrorBound();
+    TestEqual(TEXT("interpolation bound"), bound, 2.506f, 0.001f);
+
+    //float rounding of the samples on top of the analytic bound
+    float tolerance = bound + 0.02f;
+    float step = WaveTile::TILE_LENGTH / WaveTile::RESOLUTION;
+    FRandomStream random(4711);
+    for (int i = 0; i < 64; i++){
+        float t = random.FRandRange(0.0f, WaveTile::TIME_PERIOD);
+        tile->setupFrame(t);
+        for (int j = 0; j < 64; j++){
+            float x = random.FRandRange(-step, WaveTile::TILE_LENGTH + step);
+            float y = random.FRandRange(-step, WaveTile::TILE_LENGTH + step);
+            FString what = FString::Printf(TEXT("sample at %.1f %.1f time %.3f"), x, y, t);
+            if(!TestEqual(what, tile->sampleHeight(x, y), tile->evaluateAnalytic(x, y, t), tolerance)){
+                return true;
+            }
+        }
+    }
+    return true;
+}
+
+#endif
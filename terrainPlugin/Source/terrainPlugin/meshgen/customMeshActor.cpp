@@ -7,7 +7,7 @@
 #include "Components/BoxComponent.h"
 #include "KismetProceduralMeshLibrary.h"
 #include "terrainPlugin/meshgen/generation/bezierCurve.h"
-#include "terrainPlugin/meshgen/foliage/MatrixTree.h"
+#include "terrainPlugin/meshgen/foliage/TreeVariantLibrary.h"
 #include "terrainPlugin/meshgen/foliage/ETreeType.h"
 #include "GameCore/util/FVectorUtil.h"
 #include "CoreMath/Matrix/MMatrix.h"
@@ -16,6 +16,12 @@
 #include "GameCore/EntityGC/trackedActors.h"
 #include "GameCore/DebugHelper.h"
 #include "GameCore/EntityGC/EntityManagerBase.h"
+#include "terrainPlugin/meshgen/foliage/instancing/FoliageMeshRegistry.h"
+#include "terrainPlugin/meshgen/foliage/instancing/FoliageInstanceSet.h"
+#include "terrainPlugin/meshgen/foliage/instancing/foliageInstanceActor.h"
+#include "terrainPlugin/meshgen/foliage/placement/PoissonDiskSampler.h"
+#include "terrainPlugin/meshgen/foliage/rocks/RockScatter.h"
+#include "terrainPlugin/meshgen/foliage/rocks/RockVariantLibrary.h"
 #include "customMeshActor.h"
 
 
@@ -203,8 +209,7 @@ void AcustomMeshActor::createTerrainFrom2DMap(TerrainChunkSetup &package){
     TArray<FVectorTouple> &touples = package.freeFoliagePositionsRef();
 
     if(package.createTrees() && (thisTerrainType != ETerrainType::EOcean)){ 
-        float percentDensity = package.treeDensitySkalar();
-        createFoliageAndPushNodesAroundFoliageToNavMesh(touples, percentDensity);
+        createFoliageAndPushNodesAroundFoliageToNavMesh(package);
     }else{
         addRandomNodesToNavmesh(touples);
     }
@@ -296,54 +301,47 @@ void AcustomMeshActor::createCube(
 
 
 /// @brief create foliage and append it to the output mesh data, the output mesh data will
-/// get its position from the actor. The touples expected to be in local coordinate system
-/// @param touples lcoation and normal in a touple
-/// @param outputAppend for example a terrain mesh to create trees on
+/// get its position from the actor. Positions are poisson disk sampled (blue noise) on the
+/// free nodes of the chunk, same chunk same trees
+/// @param package chunk setup with the local map, occupancy grid and placement seed
 void AcustomMeshActor::createFoliageAndPushNodesAroundFoliageToNavMesh(
-    TArray<FVectorTouple> &touples,
-    float treeDensitySkalar
+    TerrainChunkSetup &package
 ){
-    
-
-    // iterate over touples
-    // determine normal angle and apply foliage, rocks, trees accordingly
+    TArray<FVectorTouple> &touples = package.freeFoliagePositionsRef();
     if (touples.Num() < 1){
         return;
     }
 
-    //saves the vertical locations to later choose random once and remove from list
-    std::vector<FVector> potentialLocations;
-    Super::filterTouplesForVerticalVectors(
-        touples,
-        potentialLocations
-    );
-
-    //create trees at random valid locations
+    //create trees at blue noise locations
     std::vector<FVector> pickedLocationsForNavmesh;
 
-
-    //int chunkScaleOneAxisInMeter = chunkScaleOneAxisLengthCm / 100;
-    //int limit = chunkScaleOneAxisInMeter / 2; // tree count
-
-    int limit = treeDensitySkalar * touples.Num();
+    int limit = package.treeDensitySkalar() * touples.Num();
     DebugHelper::logMessage("tree density limit: ", limit);
-    //limit = 10;
 
-    for (int i = 0; i < limit; i++){
+    PoissonDiskSampler sampler(
+        package.treeMinDistance(),
+        package.foliagePlacementSeed()
+    );
+    sampler.sample(
+        package.mapReference(),
+        package.freeFoliageGridRef(),
+        limit,
+        pickedLocationsForNavmesh
+    );
 
-        int index = FVectorUtil::randomNumber(0, potentialLocations.size() - 1);
-        if (index < potentialLocations.size() && index >= 0)
-        {
-            FVector vertex = potentialLocations[index];
-            pickedLocationsForNavmesh.push_back(vertex); //tree position added to navmesh
-            createTreeAndSaveToMesh(vertex);
-            
-            
-            //potentialLocations.erase(potentialLocations.begin() + index);
-            potentialLocations[index] = potentialLocations.back();
-            potentialLocations.pop_back();
+    //variant and rotation from an own stream, same chunk same trees
+    FRandomStream random(package.foliagePlacementSeed() ^ 0x27d4eb2d);
+    FoliageInstanceSet foliageInstances;
+    for (int i = 0; i < pickedLocationsForNavmesh.size(); i++){
+        FVector &vertex = pickedLocationsForNavmesh[i];
+        if(USE_INSTANCED_FOLIAGE){
+            createTreeInstance(vertex, foliageInstances, random);
+        }else{
+            createTreeAndSaveToMesh(vertex, random);
         }
     }
+    createRockInstances(package, pickedLocationsForNavmesh, foliageInstances);
+    emitFoliageInstances(foliageInstances);
 
 
     //add all points around foliage to navmesh to allow the bots to move over the terrain better
@@ -375,6 +373,7 @@ void AcustomMeshActor::createFoliageAndPushNodesAroundFoliageToNavMesh(
     }
 
     ReloadMeshAndApplyAllMaterials();
+    applyCollisionProxy(); //trees were added as box proxies
 
 }
 
@@ -383,12 +382,17 @@ void AcustomMeshActor::createFoliageAndPushNodesAroundFoliageToNavMesh(
 
 //new!
 
-void AcustomMeshActor::createTreeAndSaveToMesh(FVector &location){
+void AcustomMeshActor::createTreeAndSaveToMesh(FVector &location, FRandomStream &random){
     
-    tree.generate(thisTerrainType); 
-    
-    MeshData &currentTreeStemMesh = tree.meshDataStemByReference();
-    MeshData &currentLeafMesh = tree.meshDataLeafByReference();
+    int variantId = treeVariantFor(thisTerrainType, random);
+    FoliageMeshRegistry *registry = FoliageMeshRegistry::instance();
+    if(!registry->isValidVariant(variantId)){
+        return;
+    }
+
+    //copy the shared variant, only the copy is moved
+    MeshData currentTreeStemMesh = registry->stemMeshByReference(variantId);
+    MeshData currentLeafMesh = registry->leafMeshByReference(variantId);
 
     currentTreeStemMesh.offsetAllvertecies(location);
     currentLeafMesh.offsetAllvertecies(location);
@@ -401,6 +405,14 @@ void AcustomMeshActor::createTreeAndSaveToMesh(FVector &location){
 
     meshDataStem.append(currentTreeStemMesh);
     meshDataLeaf.append(currentLeafMesh);
+
+    //only the stem collides, leafs and wide crowns are ignored
+    FVector noOffset(0, 0, 0);
+    collisionProxy.appendBoundsProxy(
+        currentTreeStemMesh.getVerteciesRef(),
+        noOffset,
+        TREE_COLLISION_HALFWIDTH
+    );
     
 }
 
@@ -410,6 +422,97 @@ void AcustomMeshActor::createTreeAndSaveToMesh(FVector &location){
 
 
 
+/**
+ * 
+ * --- instanced foliage ---
+ * 
+ */
+
+/// @brief returns a random shared tree variant for the terrain type, the variants are
+/// generated once by the TreeVariantLibrary and shared by all chunks
+/// @param random chunk placement stream
+int AcustomMeshActor::treeVariantFor(ETerrainType type, FRandomStream &random){
+    return TreeVariantLibrary::instance()->randomVariantFor(type, random);
+}
+
+/// @brief adds an instance of a shared tree variant instead of merging the tree geometry
+/// into the chunk mesh
+/// @param location local position on the chunk
+/// @param instances set to add to
+/// @param random chunk placement stream, variant and yaw are drawn from it
+void AcustomMeshActor::createTreeInstance(
+    FVector &location,
+    FoliageInstanceSet &instances,
+    FRandomStream &random
+){
+    int variantId = treeVariantFor(thisTerrainType, random);
+    if(variantId < 0){
+        return;
+    }
+
+    FVector worldLocation = GetActorLocation() + location;
+    FRotator rotation(0, random.FRandRange(0.0f, 360.0f), 0);
+    FTransform transform(rotation, worldLocation);
+    instances.addInstance(variantId, transform);
+
+    //only the stem collides, same as for merged trees
+    float height = FoliageMeshRegistry::instance()->stemHeight(variantId);
+    collisionProxy.appendBoxProxy(location, TREE_COLLISION_HALFWIDTH, height);
+}
+
+/// @brief scatters rock instances around the already placed foliage, rocks collide
+/// with a box proxy scaled like the instance
+/// @param package chunk setup
+/// @param blockedLocations local positions of the trees
+/// @param instances set to add to
+void AcustomMeshActor::createRockInstances(
+    TerrainChunkSetup &package,
+    std::vector<FVector> &blockedLocations,
+    FoliageInstanceSet &instances
+){
+    std::vector<int> variants;
+    std::vector<FTransform> transforms;
+    RockScatter rockScatter;
+    rockScatter.scatter(package, blockedLocations, variants, transforms);
+
+    RockVariantLibrary *library = RockVariantLibrary::instance();
+    FVector actorLocation = GetActorLocation();
+    for (int i = 0; i < transforms.size(); i++){
+        FTransform &transform = transforms[i];
+        FVector location = transform.GetLocation();
+        float scale = transform.GetScale3D().X;
+
+        collisionProxy.appendBoxProxy(
+            location,
+            library->halfWidthOf(variants[i]) * scale,
+            library->heightOf(variants[i]) * scale
+        );
+
+        transform.SetLocation(location + actorLocation);
+        instances.addInstance(variants[i], transform);
+    }
+}
+
+/// @brief hands the instances to the foliage actor or only reports the counts in headless mode
+void AcustomMeshActor::emitFoliageInstances(FoliageInstanceSet &instances){
+    if(instances.instanceCount() == 0){
+        return;
+    }
+
+    if(FOLIAGE_HEADLESS){
+        instances.logReport(GetActorLocation().ToString());
+        return;
+    }
+
+    if(AfoliageInstanceActor *foliageActor = AfoliageInstanceActor::instance(GetWorld())){
+        foliageActor->addInstances(instances);
+    }
+}
+
+
+
+
+
 void AcustomMeshActor::splitIntoAllTriangles(){
     
     std::vector<MeshDataLod> newLodMeshes;
@@ -551,6 +654,11 @@ void AcustomMeshActor::glassreactionToHitLocal(FVector &hitlocal){
     if(hasGlassMesh()){
         health = 100;
 
+        //only the hit pane is edited if the panes are known
+        if(breakGlassPaneAt(hitlocal)){
+            return;
+        }
+
         MeshData &meshFound = findMeshDataReference(
             materialEnum::glassMaterial,
             ELod::lodNear,
@@ -573,6 +681,30 @@ void AcustomMeshActor::glassreactionToHitLocal(FVector &hitlocal){
 
 
 
+/// @brief breaks the pane at the hit and refreshes the glass layer without recreating it
+/// @param hitlocal hit in local space
+/// @return false if the glass layer has no pane table
+bool AcustomMeshActor::breakGlassPaneAt(FVector &hitlocal){
+    if(glassPanes.isEmpty()){
+        return false;
+    }
+    int pane = glassPanes.findPaneAt(hitlocal);
+    if(pane < 0){
+        return true; //all panes are known, no intact pane at the hit
+    }
+
+    MeshData &meshFound = findMeshDataReference(
+        materialEnum::glassMaterial,
+        ELod::lodNear,
+        true//raycastFlag
+    );
+    if(glassPanes.breakPane(pane, meshFound.getVerteciesRef()) && Mesh){
+        int layer = layerByMaterialEnum(materialEnum::glassMaterial);
+        refreshMesh(*Mesh, meshFound, layer);
+    }
+    return true;
+}
+
 bool AcustomMeshActor::hasGlassMesh(){
     MeshData &meshFound = findMeshDataReference(
         materialEnum::glassMaterial,
@@ -14,7 +14,8 @@
 #include "GameCore/MeshGenBase/foliage/ETerrainType.h"
 #include "GameCore/MeshGenBase/customMeshActorBase.h"
 #include "terrainPlugin/meshgen/generation/helper/TerrainChunkSetup.h"
-#include "terrainPlugin/meshgen/foliage/MatrixTree.h"
+#include "terrainPlugin/meshgen/foliage/instancing/FoliageInstanceSet.h"
+#include "terrainPlugin/meshgen/rooms/roomActor/helper/GlassPaneTable.h"
 #include <map>
 #include "customMeshActor.generated.h"
 
@@ -105,8 +106,6 @@ public:
 	void enableDebug();
 
 protected:
-	MatrixTree tree;
-
 	bool DEBUG_enabled = false;
 	void debugThis(FVector &hitpoint);
 
@@ -124,12 +123,25 @@ protected:
 	class IDamageinterface *damagedOwner = nullptr;
 
 
-	void createFoliageAndPushNodesAroundFoliageToNavMesh(
-		TArray<FVectorTouple> &touples,
-		float percentDensity
-	);
+	void createFoliageAndPushNodesAroundFoliageToNavMesh(TerrainChunkSetup &package);
+
+	void createTreeAndSaveToMesh(FVector &location, FRandomStream &random);
+
+	/// @brief half width of the stem collision proxy in cm
+	static const int TREE_COLLISION_HALFWIDTH = 40;
 
-	void createTreeAndSaveToMesh(FVector &location);
+	//instanced foliage
+	static const bool USE_INSTANCED_FOLIAGE = true;
+	static const bool FOLIAGE_HEADLESS = false; //only report instance and vertex counts
+	int treeVariantFor(ETerrainType type, FRandomStream &random);
+
+	void createTreeInstance(FVector &location, FoliageInstanceSet &instances, FRandomStream &random);
+	void createRockInstances(
+		TerrainChunkSetup &package,
+		std::vector<FVector> &blockedLocations,
+		FoliageInstanceSet &instances
+	);
+	void emitFoliageInstances(FoliageInstanceSet &instances);
 
 	materialEnum materialtypeSet = materialEnum::grassMaterial;
 
@@ -139,6 +151,10 @@ protected:
 
 	void glassreactionToHitWorld(FVector &hitWorld);
 	void glassreactionToHitLocal(FVector &hitlocal);
+
+	//panes of the glass layer, filled by actors which build their windows pane by pane
+	GlassPaneTable glassPanes;
+	bool breakGlassPaneAt(FVector &hitlocal);
 	void debugDrawMeshData(MeshData &meshdata);
 
 	bool hasGlassMesh();
@@ -7,9 +7,11 @@
 #include "terrainPlugin/meshgen/foliage/helper/IndexChain.h"
 #include "terrainPlugin/meshgen/foliage/helper/TreeProperties.h"
 #include "terrainPlugin/meshgen/foliage/helper/FVectorShape.h"
+#include "GameCore/MeshGenBase/MathHelp/SurfaceScatter.h"
 
 MatrixTree::MatrixTree()
 {
+    random.Initialize(0);
     loadProperties();
     generateStemShapes();
     generateLeafShapes();
@@ -95,7 +97,7 @@ TreeProperties &MatrixTree::findProperty(ETerrainType typeOfTerrain){
 
     std::vector<TreeProperties> &vec = terrainPropertyMap[typeOfTerrain];
     if(vec.size() > 0){
-        int index = FVectorUtil::randomNumber(0, vec.size());
+        int index = randomNumber(0, vec.size() - 1);
         if(index >= 0 && index < vec.size()){
             return vec[index];
         }
@@ -139,6 +141,47 @@ void MatrixTree::generate(ETerrainType terrainType){
     resetRotationMatrices(); //clean up
 }
 
+/// @brief generates a tree for a given property, used by the variant library
+/// @param properties properties of the tree
+void MatrixTree::generate(TreeProperties &properties){
+    clean();
+    processAndGenerate(properties);
+    resetRotationMatrices(); //clean up
+}
+
+/// @brief generates a tree for a given property from a seed, the same seed and property
+/// always create the same mesh data, independent of previous calls on this object
+/// @param properties properties of the tree
+/// @param seed seed for the random stream
+void MatrixTree::generate(TreeProperties &properties, int32 seed){
+    random.Initialize(seed);
+    resetRotationMatrices();
+    generateLeafShapes(); //leaf scale is random too
+    generate(properties);
+}
+
+/// @brief random number in [lower, higher] drawn from the own stream
+int MatrixTree::randomNumber(int lower, int higher){
+    if(higher < lower){
+        std::swap(lower, higher);
+    }
+    return random.RandRange(lower, higher);
+}
+
+/// @brief returns all tree properties allowed on a terrain type (copy)
+/// @param typeOfTerrain type of terrain
+/// @return properties or the default property if none is registered
+std::vector<TreeProperties> MatrixTree::propertiesFor(ETerrainType typeOfTerrain){
+    std::vector<TreeProperties> output;
+    if(terrainPropertyMap.find(typeOfTerrain) != terrainPropertyMap.end()){
+        output = terrainPropertyMap[typeOfTerrain];
+    }
+    if(output.size() == 0){
+        output.push_back(defaultProperty);
+    }
+    return output;
+}
+
 void MatrixTree::resetRotationMatrices(){
     for (int i = 0; i < matrices.size(); i++){
         MMatrix &current = matrices[i];
@@ -216,66 +259,26 @@ void MatrixTree::generateMesh(){
 }
 
 /// @brief pass in the vector of INTERPOLATED / concatenated matricies (multiplied), translation will be copied
+/// the stem is emitted from the cached ring template of the tree type, no vertex is welded
 /// @param matricesIn matricies which are only translation copies of multiplied once
 /// @param mesh mesh data to append the stem to
 void MatrixTree::wrapWithMesh(IndexChain &indexChain, MeshData &mesh){
 
     std::vector<MMatrix> &matricesIn = indexChain.matrixChain();
-    MMatrix recursionScaleMatForShapes = indexChain.scaleXYMatrixFromrecursionLevel();
-
-
-    MeshData subMesh;
-    if (matricesIn.size() > 1)
-    {
-
-        //einfach alle shapes moven und dann connecten nacheinander
-        std::vector<FVectorShape> allShapes;
-
-        //STEM DATA MOVE
-        for (int i = 0; i < matricesIn.size(); i++)
-        {
-            MMatrix &currentMatrix = matricesIn[i];
-            std::vector<FVectorShape> current = StemShapeByEnum(treeType);
-            for (int j = 0; j < current.size(); j++){
-                FVectorShape &currentShape = current[j];
-                currentShape.moveVerteciesWithButPivotCenter(recursionScaleMatForShapes);
-                currentShape.moveVerteciesWith(currentMatrix);
-                allShapes.push_back(currentShape);
-            }
-        }
+    if(matricesIn.size() <= 1){
+        return;
+    }
 
-        //STEM DATA CONNECT
-        if(allShapes.size() > 0){
-            
-            for (int i = 0; i < allShapes.size(); i++)
-            { 
-                FVectorShape &currentShape = allShapes[i];
-                currentShape.joinMeshData(subMesh);
-
-                //close top shape
-                if(i == allShapes.size() - 1){
-                    MeshData closedTop = currentShape.closeMeshAtCenter(true);
-                    subMesh.append(closedTop);
-                }
-            }
-
-            //add to leaf locations
-            leafTops.push_back(matricesIn.back());
-            
-            FVectorShape &lastShape = allShapes.back();
-            std::vector<MMatrix> leaftopLocations;
-            lastShape.copyVertecies(leaftopLocations);
-
-            for (int i = 0; i < leaftopLocations.size(); i++){
-                leafTops.push_back(leaftopLocations[i]);
-            }
-        }
-        
-        subMesh.calculateNormals();
+    StemRingTemplate *stemTemplate = stemTemplateByEnum(treeType);
+    if(stemTemplate == nullptr){
+        return;
     }
 
-    //mesh.append(subMesh); //add new subtree mesh to data
-    mesh.appendEfficent(subMesh); //NEW
+    MMatrix recursionScaleMatForShapes = indexChain.scaleXYMatrixFromrecursionLevel();
+
+    //add to leaf locations, top ring is appended by the template
+    leafTops.push_back(matricesIn.back());
+    stemTemplate->emit(matricesIn, recursionScaleMatForShapes, mesh, leafTops);
 }
 
 
@@ -295,7 +298,7 @@ void MatrixTree::createSubTrees(MMatrix &offset, TreeProperties &prop, int recur
     /**
      * FURTHER TESTING NEEDED, bei subtree count 1 macht das keinen sinn, sieht doof aus.
      */
-    int count = prop.subTreeCount();
+    int count = prop.subTreeCount(random);
     for (int i = 0; i < count; i++)
     {
         IndexChain subtree = createSubTree(offset, prop);
@@ -331,10 +334,11 @@ IndexChain MatrixTree::createSubTree(
     IndexChain subtree;
     subtree.setOffsetMatrix(offset);
 
-    for (int i = 0; i < prop.partsPerSubtree(); i++){
-        int random = FVectorUtil::randomNumber(1, matrices.size() - 1); //only stem can have index 0 as start!
-        if(indexIsValid(random)){
-            subtree.addIndex(random);
+    int parts = prop.partsPerSubtree(random);
+    for (int i = 0; i < parts; i++){
+        int index = randomNumber(1, matrices.size() - 1); //only stem can have index 0 as start!
+        if(indexIsValid(index)){
+            subtree.addIndex(index);
         }
     }
     buildChain(subtree);
@@ -380,8 +384,8 @@ void MatrixTree::randomRotationForAllMatrices(){
     int rotMax = rotationRangeByEnum(treeType);
     for (int i = 0; i < matrices.size(); i++)
     {
-        float pitch = MMatrix::degToRadian(FVectorUtil::randomNumber(prevPitch - rotMax, prevPitch + rotMax));
-        float yaw = MMatrix::degToRadian(FVectorUtil::randomNumber(prevYaw - rotMax, prevYaw + rotMax));
+        float pitch = MMatrix::degToRadian(randomNumber(prevPitch - rotMax, prevPitch + rotMax));
+        float yaw = MMatrix::degToRadian(randomNumber(prevYaw - rotMax, prevYaw + rotMax));
         MMatrix &current = matrices[i];
         current.pitchRadAdd(pitch);
         current.yawRadAdd(yaw);
@@ -395,17 +399,17 @@ void MatrixTree::randomRotationForAllMatrices(){
 
 MMatrix MatrixTree::randomRotator(){
     MMatrix rotator;
-    rotator.rollRadAdd(MMatrix::degToRadian(FVectorUtil::randomNumber(-90,90)));
-    rotator.pitchRadAdd(MMatrix::degToRadian(FVectorUtil::randomNumber(-90,90)));
-    rotator.yawRadAdd(MMatrix::degToRadian(FVectorUtil::randomNumber(-90,90)));
+    rotator.rollRadAdd(MMatrix::degToRadian(randomNumber(-90,90)));
+    rotator.pitchRadAdd(MMatrix::degToRadian(randomNumber(-90,90)));
+    rotator.yawRadAdd(MMatrix::degToRadian(randomNumber(-90,90)));
     return rotator;
 }
 
 MMatrix MatrixTree::randomRotator(int lower, int heigher){
     MMatrix rotator;
-    rotator.rollRadAdd(MMatrix::degToRadian(FVectorUtil::randomNumber(lower,heigher)));
-    rotator.pitchRadAdd(MMatrix::degToRadian(FVectorUtil::randomNumber(lower,heigher)));
-    rotator.yawRadAdd(MMatrix::degToRadian(FVectorUtil::randomNumber(lower,heigher)));
+    rotator.rollRadAdd(MMatrix::degToRadian(randomNumber(lower,heigher)));
+    rotator.pitchRadAdd(MMatrix::degToRadian(randomNumber(lower,heigher)));
+    rotator.yawRadAdd(MMatrix::degToRadian(randomNumber(lower,heigher)));
     return rotator;
 }
 
@@ -487,27 +491,13 @@ void MatrixTree::generateCactusSpikes(){
 
 
     
-    // copy and move spike to position as wanted
-    std::vector<MMatrix> transformMatrices;
-    //stemMeshData.generateMatricesPerFaceAndLookDirOfNormal(transformMatrices);
-
-    int stepSizeBetweenVertecies = height; //is random...
-    stemMeshData.generateMatricesPerFaceAndLookDirOfNormal(
-        transformMatrices
-        //,stepSizeBetweenVertecies
-    );
-
-    for (int i = 0; i < transformMatrices.size(); i++)
-    {
-        MMatrix &currentMatrix = transformMatrices[i];
-        MeshData copy = sampleSpike;
-        copy.transformAllVertecies(currentMatrix);
-        
-        leafMeshData.append(copy);
-    }
+    // one frame per stem face, all spikes are transformed and appended in one batch
+    SurfaceScatter scatter;
+    scatter.buildFaceFrames(stemMeshData);
+    scatter.instanceTemplate(sampleSpike, leafMeshData);
 
     //debug
-    //FString message = FString::Printf(TEXT("size of matrices: %d"), transformMatrices.size()); //500
+    //FString message = FString::Printf(TEXT("size of frames: %d"), scatter.num()); //500
     //DebugHelper::logMessage(message);
 }
 
@@ -522,13 +512,16 @@ void MatrixTree::generateCactusSpikes(){
 /// @brief creates a stem shape with the pivot at 0,0,0 and mesh reaching upwards
 /// @param type 
 /// @return 
-std::vector<FVectorShape> MatrixTree::StemShapeByEnum(ETreeType type){
-    std::vector<FVectorShape> output;
-
-    if(stemMap.find(type) != stemMap.end()){
-        output = stemMap[type];
+/// @brief returns the cached stem template of the type
+/// @return template or nullptr if none exists
+StemRingTemplate *MatrixTree::stemTemplateByEnum(ETreeType type){
+    if(stemTemplateMap.find(type) != stemTemplateMap.end()){
+        StemRingTemplate *found = &stemTemplateMap[type];
+        if(found->isValid()){
+            return found;
+        }
     }
-    return output;
+    return nullptr;
 }
 
 
@@ -596,8 +589,8 @@ void MatrixTree::generateStemShapeFor(ETreeType type){
         output.push_back(shapeCircle);
     }
 
-    //add to map here
-    stemMap[type] = output;
+    //add to map here, the template is immutable from now on
+    stemTemplateMap[type] = StemRingTemplate(output);
 }
 
 
@@ -647,7 +640,7 @@ void MatrixTree::generateLeafShape(ETreeType type){
         output.push_back(oneSide); 
         MMatrix scaleUp;
 
-        int scaleUpRand = FVectorUtil::randomNumber(3, 10);
+        int scaleUpRand = randomNumber(3, 10);
         scaleUp.scaleUniform(scaleUpRand);
         output.moveVerteciesWith(scaleUp);
 
@@ -3,11 +3,13 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Math/RandomStream.h"
 #include "CoreMath/Matrix/MMatrix.h"
 #include "GameCore/MeshGenBase/MeshData/MeshData.h"
 #include "terrainPlugin/meshgen/foliage/helper/IndexChain.h"
 #include "terrainPlugin/meshgen/foliage/helper/TreeProperties.h"
 #include "terrainPlugin/meshgen/foliage/helper/FVectorShape.h"
+#include "terrainPlugin/meshgen/foliage/helper/StemRingTemplate.h"
 #include <map>
 #include "ETreeType.h"
 
@@ -21,11 +23,20 @@ public:
 	~MatrixTree();
 
 	void generate(ETerrainType type);
+	void generate(TreeProperties &properties);
+	void generate(TreeProperties &properties, int32 seed);
+
+	std::vector<TreeProperties> propertiesFor(ETerrainType type);
 
 	MeshData &meshDataStemByReference();
 	MeshData &meshDataLeafByReference();
 
 private:
+	/// @brief explicit random stream per tree, no global state: trees can be generated
+	/// on any thread and the same seed gives the same tree
+	FRandomStream random;
+	int randomNumber(int lower, int higher);
+
 	void clean();
 	void resetRotationMatrices();
 
@@ -54,7 +65,7 @@ private:
 
 	std::vector<MMatrix> leafTops;
 
-	std::vector<FVectorShape> StemShapeByEnum(ETreeType type);
+	StemRingTemplate *stemTemplateByEnum(ETreeType type);
 	void buildChain(IndexChain &indexChain);
 
 	FVectorShape leafShapeByEnum(ETreeType type);
@@ -99,7 +110,8 @@ private:
 	void generateStemShapes();
 	void generateStemShapeFor(ETreeType type);
 
-	std::map<ETreeType, std::vector<FVectorShape>> stemMap;
+	/// @brief ring templates per stem type, built once in the constructor
+	std::map<ETreeType, StemRingTemplate> stemTemplateMap;
 	std::map<ETreeType, FVectorShape> leafMap;
 
 };
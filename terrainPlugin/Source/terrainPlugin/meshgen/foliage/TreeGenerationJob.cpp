@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TreeGenerationJob.h"
+#include "Async/ParallelFor.h"
+#include "terrainPlugin/meshgen/foliage/MatrixTree.h"
+
+TreeGenerationJob::TreeGenerationJob()
+{
+}
+
+TreeGenerationJob::TreeGenerationJob(TreeProperties &propertiesIn, int32 seedIn)
+{
+    properties = propertiesIn;
+    seedSaved = seedIn;
+}
+
+TreeGenerationJob::TreeGenerationJob(const TreeGenerationJob &other){
+    *this = other;
+}
+
+TreeGenerationJob &TreeGenerationJob::operator=(const TreeGenerationJob &other){
+    if(this == &other){
+        return *this;
+    }
+    properties = other.properties;
+    seedSaved = other.seedSaved;
+    done = other.done;
+    stemMeshData = other.stemMeshData;
+    leafMeshData = other.leafMeshData;
+    return *this;
+}
+
+TreeGenerationJob::~TreeGenerationJob()
+{
+}
+
+/// @brief generates the tree, safe to call from any thread: no shared state is touched
+void TreeGenerationJob::execute(){
+    MatrixTree tree;
+    tree.generate(properties, seedSaved);
+    stemMeshData = tree.meshDataStemByReference();
+    leafMeshData = tree.meshDataLeafByReference();
+    done = true;
+}
+
+bool TreeGenerationJob::isDone(){
+    return done;
+}
+
+int32 TreeGenerationJob::seed(){
+    return seedSaved;
+}
+
+TreeProperties &TreeGenerationJob::propertiesByReference(){
+    return properties;
+}
+
+MeshData &TreeGenerationJob::meshDataStemByReference(){
+    return stemMeshData;
+}
+
+MeshData &TreeGenerationJob::meshDataLeafByReference(){
+    return leafMeshData;
+}
+
+/// @brief executes all jobs on the task graph workers and returns when all are done,
+/// the results stay in the jobs (same order) and are merged by the caller
+/// @param jobs jobs to execute
+void TreeGenerationJob::runParallel(std::vector<TreeGenerationJob> &jobs){
+    ParallelFor(jobs.size(), [&jobs](int32 index){
+        jobs[index].execute();
+    });
+}
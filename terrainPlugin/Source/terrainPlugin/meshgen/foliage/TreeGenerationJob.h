@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameCore/MeshGenBase/MeshData/MeshData.h"
+#include "terrainPlugin/meshgen/foliage/helper/TreeProperties.h"
+#include <vector>
+
+/**
+ * one independent tree generation: properties and seed in, stem and leaf mesh data out.
+ * Each job owns its own MatrixTree and random stream, jobs can run on worker threads
+ * and the result only depends on the properties and the seed.
+ */
+class TERRAINPLUGIN_API TreeGenerationJob
+{
+public:
+	TreeGenerationJob();
+	TreeGenerationJob(TreeProperties &propertiesIn, int32 seedIn);
+	TreeGenerationJob(const TreeGenerationJob &other);
+	TreeGenerationJob &operator=(const TreeGenerationJob &other);
+	~TreeGenerationJob();
+
+	void execute();
+
+	bool isDone();
+	int32 seed();
+	TreeProperties &propertiesByReference();
+	MeshData &meshDataStemByReference();
+	MeshData &meshDataLeafByReference();
+
+	static void runParallel(std::vector<TreeGenerationJob> &jobs);
+
+private:
+	TreeProperties properties;
+	int32 seedSaved = 0;
+	bool done = false;
+
+	MeshData stemMeshData;
+	MeshData leafMeshData;
+};
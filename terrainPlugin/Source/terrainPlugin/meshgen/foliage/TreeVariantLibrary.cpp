@@ -0,0 +1,147 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TreeVariantLibrary.h"
+#include "GameCore/MeshGenBase/customMeshActorBase.h"
+#include "terrainPlugin/meshgen/foliage/instancing/FoliageMeshRegistry.h"
+#include "terrainPlugin/meshgen/foliage/TreeGenerationJob.h"
+#include <cstdlib>
+
+TreeVariantLibrary *TreeVariantLibrary::instancePointer = nullptr;
+
+void TreeVariantLibrary::EndGame(){
+    if(TreeVariantLibrary *ptr = instancePointer){
+        delete ptr;
+        TreeVariantLibrary::instancePointer = nullptr;
+    }
+}
+
+/// @brief you are not allowed to delete this pointer!
+/// @return instance pointer
+TreeVariantLibrary *TreeVariantLibrary::instance(){
+    if(TreeVariantLibrary::instancePointer == nullptr){
+        TreeVariantLibrary::instancePointer = new TreeVariantLibrary();
+    }
+    return TreeVariantLibrary::instancePointer;
+}
+
+TreeVariantLibrary::TreeVariantLibrary()
+{
+}
+
+TreeVariantLibrary::~TreeVariantLibrary()
+{
+    variantsByTreeType.clear();
+    variantsByTerrainType.clear();
+}
+
+/// @brief seed of a variant, same tree type and index always give the same seed
+int TreeVariantLibrary::seedFor(ETreeType type, int variantIndex){
+    return 7919 + ((int)type) * 1000 + variantIndex;
+}
+
+/// @brief generates the variants of all tree properties allowed on the terrain type,
+/// properties shared by more than one terrain type are only generated once
+void TreeVariantLibrary::pregenerate(ETerrainType type){
+    if(variantsByTerrainType.find(type) != variantsByTerrainType.end()){
+        return;
+    }
+
+    std::vector<TreeProperties> properties = tree.propertiesFor(type);
+    generateVariantsFor(properties);
+
+    std::vector<int> &terrainVariants = variantsByTerrainType[type];
+    for (int i = 0; i < properties.size(); i++){
+        std::vector<int> &ids = variantsFor(properties[i].getTreeType());
+        for (int j = 0; j < ids.size(); j++){
+            terrainVariants.push_back(ids[j]);
+        }
+    }
+}
+
+/// @brief generates the variants of all terrain types in one parallel batch
+void TreeVariantLibrary::pregenerateAll(){
+    std::vector<ETerrainType> types = AcustomMeshActorBase::terrainVector();
+
+    std::vector<TreeProperties> properties;
+    for (int i = 0; i < types.size(); i++){
+        std::vector<TreeProperties> current = tree.propertiesFor(types[i]);
+        for (int j = 0; j < current.size(); j++){
+            properties.push_back(current[j]);
+        }
+    }
+    generateVariantsFor(properties);
+
+    for (int i = 0; i < types.size(); i++){
+        pregenerate(types[i]);
+    }
+}
+
+/// @brief generates VARIANTS_PER_PROPERTY variants for each tree type not generated yet.
+/// Every variant is an independent seeded job, the jobs run in parallel and are
+/// registered afterwards on this thread in job order: ids and meshes are the same
+/// for every run, independent of the thread scheduling
+/// @param properties properties to generate, duplicate tree types are skipped
+void TreeVariantLibrary::generateVariantsFor(std::vector<TreeProperties> &properties){
+    std::vector<TreeGenerationJob> jobs;
+    std::vector<ETreeType> jobTypes;
+    for (int i = 0; i < properties.size(); i++){
+        TreeProperties &current = properties[i];
+        ETreeType treeType = current.getTreeType();
+        if(variantsByTreeType.find(treeType) != variantsByTreeType.end()){
+            continue;
+        }
+        variantsByTreeType[treeType]; //mark as generated, duplicates are skipped
+
+        for (int j = 0; j < VARIANTS_PER_PROPERTY; j++){
+            jobs.push_back(TreeGenerationJob(current, seedFor(treeType, j)));
+            jobTypes.push_back(treeType);
+        }
+    }
+    if(jobs.size() == 0){
+        return;
+    }
+
+    TreeGenerationJob::runParallel(jobs);
+
+    FoliageMeshRegistry *registry = FoliageMeshRegistry::instance();
+    for (int i = 0; i < jobs.size(); i++){
+        TreeGenerationJob &job = jobs[i];
+        int id = registry->registerVariant(
+            job.meshDataStemByReference(),
+            job.meshDataLeafByReference(),
+            true
+        );
+        variantsByTreeType[jobTypes[i]].push_back(id);
+    }
+}
+
+/// @brief picks a variant for the terrain type with the passed stream,
+/// generates the variants if needed
+/// @return variant id in the FoliageMeshRegistry or -1 if none
+int TreeVariantLibrary::randomVariantFor(ETerrainType type, FRandomStream &random){
+    std::vector<int> &ids = variantsFor(type);
+    if(ids.size() == 0){
+        return -1;
+    }
+    return variantFor(type, random.RandRange(0, ids.size() - 1));
+}
+
+/// @brief returns the variant at pick (wrapped) for the terrain type
+int TreeVariantLibrary::variantFor(ETerrainType type, int pick){
+    std::vector<int> &ids = variantsFor(type);
+    if(ids.size() == 0){
+        return -1;
+    }
+    int index = std::abs(pick) % ids.size();
+    return ids[index];
+}
+
+std::vector<int> &TreeVariantLibrary::variantsFor(ETerrainType type){
+    pregenerate(type);
+    return variantsByTerrainType[type];
+}
+
+std::vector<int> &TreeVariantLibrary::variantsFor(ETreeType type){
+    return variantsByTreeType[type];
+}
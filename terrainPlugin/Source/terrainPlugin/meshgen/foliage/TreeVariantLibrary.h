@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameCore/MeshGenBase/foliage/ETerrainType.h"
+#include "terrainPlugin/meshgen/foliage/MatrixTree.h"
+#include "terrainPlugin/meshgen/foliage/ETreeType.h"
+#include <map>
+#include <vector>
+
+/**
+ * pre generates K seeded tree variants per tree property (and by that per terrain type)
+ * once and shares them for all chunks. The meshes are stored in the FoliageMeshRegistry,
+ * a placement only selects a variant id and a transform.
+ */
+class TERRAINPLUGIN_API TreeVariantLibrary
+{
+public:
+	static TreeVariantLibrary *instance();
+	static void EndGame();
+	~TreeVariantLibrary();
+
+	/// @brief variants generated per tree property
+	static const int VARIANTS_PER_PROPERTY = 4;
+
+	void pregenerate(ETerrainType type);
+	void pregenerateAll();
+
+	int randomVariantFor(ETerrainType type, FRandomStream &random);
+	int variantFor(ETerrainType type, int pick);
+
+	std::vector<int> &variantsFor(ETerrainType type);
+	std::vector<int> &variantsFor(ETreeType type);
+
+	static int seedFor(ETreeType type, int variantIndex);
+
+private:
+	TreeVariantLibrary();
+	static class TreeVariantLibrary *instancePointer;
+
+	/// @brief only used for the tree properties, the variants are generated by TreeGenerationJob
+	MatrixTree tree;
+
+	std::map<ETreeType, std::vector<int>> variantsByTreeType;
+	std::map<ETerrainType, std::vector<int>> variantsByTerrainType;
+
+	void generateVariantsFor(std::vector<TreeProperties> &properties);
+};
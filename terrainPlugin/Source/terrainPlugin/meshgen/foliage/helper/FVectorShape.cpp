@@ -46,16 +46,13 @@ void FVectorShape::moveVerteciesWith(MMatrix &mat){
 }
 
 ///@brief moves the vertecies with a matrix with moving it first to the center for a pivot
+/// one pass in place: v = mat * (v - center) + center
 void FVectorShape::moveVerteciesWithButPivotCenter(MMatrix &mat){
     FVector center = calculateCenter();
-    FVector toPivot = center * -1.0f;
-    MMatrix moveToCenter(toPivot);
-    moveVerteciesWith(moveToCenter);
-
-    moveVerteciesWith(mat);
-
-    MMatrix moveBack(center);
-    moveVerteciesWith(moveBack);
+    for (int i = 0; i < vec.size(); i++){
+        FVector local = vec[i] - center;
+        vec[i] = (mat * local) + center;
+    }
 }
 
 void FVectorShape::push_back(FVector other){
@@ -63,12 +60,14 @@ void FVectorShape::push_back(FVector other){
 }
 
 void FVectorShape::push_back(FVectorShape &other){
+    vec.reserve(vec.size() + other.vec.size());
     for (int i = 0; i < other.vec.size(); i++){
         vec.push_back(other.vec[i]);
     }
 }
 
 void FVectorShape::push_back(std::vector<FVector> &other){
+    vec.reserve(vec.size() + other.size());
     for (int i = 0; i < other.size(); i++){
         vec.push_back(other[i]);
     }
@@ -132,6 +131,7 @@ FVector FVectorShape::calculateCenter(){
 /// @brief creates vertecies in mmatrix represantation
 /// @param output 
 void FVectorShape::copyVertecies(std::vector<MMatrix> &output){
+    output.reserve(output.size() + vec.size());
     for (int i = 0; i < vec.size(); i++){
         MMatrix mat;
         mat.setTranslation(vec[i]);
@@ -158,6 +158,20 @@ void FVectorShape::randomizeVertecies(int maxdistance){
     }
 }
 
+/// @brief same as randomizeVertecies but seeded, for reproducable shapes
+void FVectorShape::randomizeVertecies(int maxdistance, FRandomStream &random){
+    maxdistance = std::abs(maxdistance);
+    FVector center = calculateCenter();
+    for (int i = 0; i < vec.size(); i++)
+    {
+        FVector &current = vec[i];
+        FVector dir = center - current;
+        dir = dir.GetSafeNormal();
+
+        current += dir * random.RandRange(-maxdistance, maxdistance);
+    }
+}
+
 
 
 
@@ -179,19 +193,28 @@ void FVectorShape::smoothWithBezier(){
 }
 
 void FVectorShape::smoothWithBezier(int detailStep){
+    ShapeArena arena;
+    smoothWithBezier(detailStep, arena);
+}
+
+/// @brief smooths the shape using the buffers of the arena, the result is swapped in
+/// so the old vertex buffer is kept by the arena for the next call
+/// @param detailStep einheits value of the curve
+/// @param arena scratch memory owned by the caller
+void FVectorShape::smoothWithBezier(int detailStep, ShapeArena &arena){
     if(vec.size() == 0){
         return;
     }
 
-    std::vector<FVector> output;
-    bezierCurve curve;
-    curve.calculatecurve(
+    std::vector<FVector> &output = arena.vertecies;
+    output.clear();
+    arena.curve.calculatecurve(
         vec,
         output,
         detailStep // einheits value
     );
 
-    vec = output;
+    vec.swap(output);
 }
 
 
@@ -242,6 +265,18 @@ std::vector<FVector> FVectorShape::vectorCopy(){
     return vec;
 }
 
+/// @brief returns the vertecies by reference, no copy, valid as long as the shape lives
+std::vector<FVector> &FVectorShape::vectorRef(){
+    return vec;
+}
+
+/// @brief reserves space for an amount of vertecies in total
+void FVectorShape::reserve(int count){
+    if(count > 0){
+        vec.reserve(count);
+    }
+}
+
 /// @brief adds a circle to the vector in CLOCKWISE ORDER (Important for mesh gen) PIVOT AT CENTER XY
 /// regardless of the 
 /// current vec, it gets pushed back
@@ -253,6 +288,7 @@ void FVectorShape::createCircleShape(int radius, int detail){
         detail = 4;
     }
 
+    vec.reserve(vec.size() + detail);
     FVector baseVector(radius, 0, 0);
     int part = (360 / detail) * -1; //CLOCK WISE FOR CORRECT TRIANGLE WINDING ORDER
     for (int i = 0; i < detail; i++)
@@ -274,6 +310,7 @@ void FVectorShape::createCircleShapeOnPitchRotation(int radius, int detail){
         detail = 4;
     }
 
+    vec.reserve(vec.size() + detail);
     FVector baseVector(0, 0, radius);
     float part = -360.0f / detail; 
     for (int i = 0; i < detail; i++)
@@ -292,6 +329,7 @@ void FVectorShape::createHalfCircleShapeOnPitchRotation(int radius, int detail){
         detail = 4;
     }
 
+    vec.reserve(vec.size() + detail + 1);
     FVector baseVector(0, 0, radius);
     //int part = ((180 / detail) * -1); //0,90,180,270,360
     float part = -180.0f / detail;
@@ -316,6 +354,7 @@ void FVectorShape::createSpikedCircleShape(int radius, int radiusInner, int deta
         detail = 4;
     }
 
+    vec.reserve(vec.size() + detail * 2);
     FVector baseVectorOuter(radius, 0, 0);
     int part = (360 / detail) * -1; //CLOCK WISE FOR CORRECT TRIANGLE WINDING ORDER
 
@@ -354,6 +393,13 @@ void FVectorShape::createQuadShape(int sizeTotal){
 /// @param sizeXYMax size of shape initially
 /// @param smoothStep smooth step of curve 
 void FVectorShape::createRandomNewSmoothedShape(int sizeXYMax, int smoothStep){
+    ShapeArena arena;
+    createRandomNewSmoothedShape(sizeXYMax, smoothStep, arena);
+}
+
+/// @brief same as createRandomNewSmoothedShape but smooths with the buffers of the arena,
+/// the own vertex buffer is cleared, not freed, so a reused shape doesnt allocate
+void FVectorShape::createRandomNewSmoothedShape(int sizeXYMax, int smoothStep, ShapeArena &arena){
     vec.clear();
 
     int radius = sizeXYMax / 2;
@@ -365,14 +411,19 @@ void FVectorShape::createRandomNewSmoothedShape(int sizeXYMax, int smoothStep){
         //close
         vec.push_back(vec[0]);
         
-        smoothWithBezier(smoothStep);
+        smoothWithBezier(smoothStep, arena);
     }
     
 }
 
 
 void FVectorShape::createRandomNewSmoothedShapeClamped(int sizeXYMax, int smoothStep){
-    createRandomNewSmoothedShape(sizeXYMax, smoothStep);
+    ShapeArena arena;
+    createRandomNewSmoothedShapeClamped(sizeXYMax, smoothStep, arena);
+}
+
+void FVectorShape::createRandomNewSmoothedShapeClamped(int sizeXYMax, int smoothStep, ShapeArena &arena){
+    createRandomNewSmoothedShape(sizeXYMax, smoothStep, arena);
 
     /*
     int limit = sizeXYMax - 1;
@@ -432,6 +483,13 @@ void FVectorShape::sortVerteciesOnXAxis(){
 
 
 MeshData FVectorShape::createSphere(int radius, int detail, bool faceOutside){
+    ShapeArena arena;
+    return createSphere(radius, detail, faceOutside, arena);
+}
+
+/// @brief creates a sphere, each rotated ring is written into the ring buffer of the arena
+/// instead of copying the whole half circle shape per ring
+MeshData FVectorShape::createSphere(int radius, int detail, bool faceOutside, ShapeArena &arena){
     MeshData outMeshData;
     detail = std::abs(detail);
     if(detail < 8){
@@ -445,13 +503,18 @@ MeshData FVectorShape::createSphere(int radius, int detail, bool faceOutside){
 
     FVectorShape newShape;
     newShape.createHalfCircleShapeOnPitchRotation(radius, detail); //around pitch
+
+    std::vector<FVector> &ring = arena.ring;
+    ring.resize(newShape.vec.size());
     for (int i = 0; i < detail; i++)
     {
         MMatrix rotatorMat;
         rotatorMat.yawRadAdd(MMatrix::degToRadian(part * i));
 
-        FVectorShape copy(newShape, rotatorMat);
-        outMeshData.appendVertecies(copy.vec); // face inside
+        for (int j = 0; j < newShape.vec.size(); j++){
+            ring[j] = rotatorMat * newShape.vec[j];
+        }
+        outMeshData.appendVertecies(ring); // face inside
     }
     outMeshData.appendVertecies(newShape.vec); //last closing
 
@@ -496,14 +559,18 @@ MeshData FVectorShape::createHalfSphereCuttedOff(
 
     FVectorShape newShape;
     newShape.createHalfCircleShapeOnPitchRotation(radius, halfDetail); //around pitch
+
+    std::vector<FVector> ring(newShape.vec.size());
     for (int i = 0; i < halfDetail; i++)
     {
         MMatrix rotatorMat;
         rotatorMat.yawRadAdd(MMatrix::degToRadian(90)); //create proper x axis alignment because pitch rot is 90 off!
         rotatorMat.yawRadAdd(MMatrix::degToRadian(part * i));
 
-        FVectorShape copy(newShape, rotatorMat);
-        outMeshData.appendVertecies(copy.vec); // face inside
+        for (int j = 0; j < newShape.vec.size(); j++){
+            ring[j] = rotatorMat * newShape.vec[j];
+        }
+        outMeshData.appendVertecies(ring); // face inside
 
     }
 
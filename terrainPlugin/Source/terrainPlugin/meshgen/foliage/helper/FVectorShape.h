@@ -3,8 +3,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Math/RandomStream.h"
 #include "CoreMath/Matrix/MMatrix.h"
 #include "GameCore/MeshGenBase/MeshData/MeshData.h"
+#include "terrainPlugin/meshgen/foliage/helper/ShapeArena.h"
 
 /**
  * 
@@ -39,10 +41,12 @@ public:
 	void copyVertecies(std::vector<MMatrix> &output);
 
 	void randomizeVertecies(int maxdistance);
+	void randomizeVertecies(int maxdistance, FRandomStream &random);
 
 
 	void smoothWithBezier();
 	void smoothWithBezier(int detailStep);
+	void smoothWithBezier(int detailStep, ShapeArena &arena);
 
 	int vertexCount();
 	void keepVertexCountFromFront(int countLimit);
@@ -51,11 +55,15 @@ public:
 	void makeCenterPivot();
 
 	void createRandomNewSmoothedShape(int sizeXYMax, int smoothStep);
+	void createRandomNewSmoothedShape(int sizeXYMax, int smoothStep, ShapeArena &arena);
 	void createRandomNewSmoothedShapeClamped(int sizeXYMax, int smoothStep);
+	void createRandomNewSmoothedShapeClamped(int sizeXYMax, int smoothStep, ShapeArena &arena);
 	void sortVerteciesOnXAxis();
 	void floorAllCoordinateValues();
 
 	std::vector<FVector> vectorCopy();
+	std::vector<FVector> &vectorRef();
+	void reserve(int count);
 
 	void createCircleShape(int radius, int detail);
 	void createCircleShapeOnPitchRotation(int radius, int detail);
@@ -64,6 +72,7 @@ public:
 	void createQuadShape(int sizeTotal);
 
 	static MeshData createSphere(int radius, int detail, bool faceOutside);
+	static MeshData createSphere(int radius, int detail, bool faceOutside, ShapeArena &arena);
 	static MeshData createHalfSphereCuttedOff(
 		int radius,
 		int fullCircleDetail,
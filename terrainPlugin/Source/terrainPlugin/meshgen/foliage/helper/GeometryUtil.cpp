@@ -0,0 +1,349 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GeometryUtil.h"
+#include "GrahamScan.h"
+#include "GameCore/DebugHelper.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+GeometryUtil::GeometryUtil()
+{
+}
+
+GeometryUtil::~GeometryUtil()
+{
+}
+
+
+/**
+ * 
+ * --- nearest neighbour ordering ---
+ * 
+ */
+
+/// @brief reorders the points in place so each point is followed by the closest not yet
+/// used point, starting at startIndex. Ties are resolved by the lower original index
+/// like the linear version, so both return the same order.
+/// @param points points to sort
+/// @param startIndex index of the first point
+void GeometryUtil::orderByNearestNeighbour(TArrayView<FVector> points, int startIndex){
+    int count = points.Num();
+    if(count < 3 || startIndex < 0 || startIndex >= count){
+        return;
+    }
+    if(count <= LINEAR_LIMIT){
+        orderByNearestNeighbourLinear(points, startIndex);
+        return;
+    }
+
+    //bounds on xy
+    FVector min = points[0];
+    FVector max = points[0];
+    for (int i = 1; i < count; i++){
+        min = min.ComponentMin(points[i]);
+        max = max.ComponentMax(points[i]);
+    }
+
+    //about 2 points per cell
+    int cellsPerAxis = std::max(1, (int)std::sqrt(count / 2.0f));
+    float extent = std::max(max.X - min.X, max.Y - min.Y);
+    float cellSize = extent / cellsPerAxis;
+    if(cellSize <= 0.0f){
+        cellSize = 1.0f;
+    }
+
+    auto cellIndexOf = [&](const FVector &point, int &cellX, int &cellY){
+        cellX = std::min(cellsPerAxis - 1, (int)((point.X - min.X) / cellSize));
+        cellY = std::min(cellsPerAxis - 1, (int)((point.Y - min.Y) / cellSize));
+    };
+
+    //counting sort of the indices into the cells
+    int cellCount = cellsPerAxis * cellsPerAxis;
+    std::vector<int> cellOf(count);
+    std::vector<int> cellStart(cellCount + 1, 0);
+    std::vector<int> cellLiving(cellCount, 0);
+    for (int i = 0; i < count; i++){
+        int cellX, cellY;
+        cellIndexOf(points[i], cellX, cellY);
+        cellOf[i] = cellX * cellsPerAxis + cellY;
+        cellLiving[cellOf[i]]++;
+    }
+    for (int i = 0; i < cellCount; i++){
+        cellStart[i + 1] = cellStart[i] + cellLiving[i];
+        cellLiving[i] = 0;
+    }
+    std::vector<int> cellItems(count);
+    for (int i = 0; i < count; i++){
+        int cell = cellOf[i];
+        cellItems[cellStart[cell] + cellLiving[cell]] = i;
+        cellLiving[cell]++;
+    }
+
+    //used points are swapped behind the living range of their cell
+    auto removeFromCell = [&](int index){
+        int cell = cellOf[index];
+        int begin = cellStart[cell];
+        int last = begin + cellLiving[cell] - 1;
+        for (int i = begin; i <= last; i++){
+            if(cellItems[i] == index){
+                std::swap(cellItems[i], cellItems[last]);
+                cellLiving[cell]--;
+                return;
+            }
+        }
+    };
+
+    std::vector<int> order;
+    order.reserve(count);
+    order.push_back(startIndex);
+    removeFromCell(startIndex);
+
+    int current = startIndex;
+    while(order.size() < count){
+        FVector &from = points[current];
+        int cellX, cellY;
+        cellIndexOf(from, cellX, cellY);
+
+        int best = -1;
+        float bestDistSquared = std::numeric_limits<float>::max();
+
+        //rings around the own cell, the xy distance is a lower bound of the 3d distance
+        for (int ring = 0; ring < cellsPerAxis; ring++){
+            if(best != -1){
+                float ringDistance = (ring - 1) * cellSize;
+                if(ringDistance * ringDistance > bestDistSquared){
+                    break;
+                }
+            }
+
+            int minX = cellX - ring;
+            int maxX = cellX + ring;
+            int minY = cellY - ring;
+            int maxY = cellY + ring;
+            for (int x = minX; x <= maxX; x++){
+                if(x < 0 || x >= cellsPerAxis){
+                    continue;
+                }
+                //only the border of the ring, inner cells were visited before
+                bool borderColumn = x == minX || x == maxX;
+                int stepY = borderColumn ? 1 : maxY - minY;
+                for (int y = minY; y <= maxY; y += std::max(1, stepY)){
+                    if(y < 0 || y >= cellsPerAxis){
+                        continue;
+                    }
+                    int cell = x * cellsPerAxis + y;
+                    int begin = cellStart[cell];
+                    int end = begin + cellLiving[cell];
+                    for (int i = begin; i < end; i++){
+                        int index = cellItems[i];
+                        float distSquared = FVector::DistSquared(points[index], from);
+                        if(distSquared < bestDistSquared || (distSquared == bestDistSquared && index < best)){
+                            bestDistSquared = distSquared;
+                            best = index;
+                        }
+                    }
+                }
+            }
+        }
+
+        if(best == -1){
+            break; //cant happen, all points are in the grid
+        }
+        order.push_back(best);
+        removeFromCell(best);
+        current = best;
+    }
+
+    applyOrder(points, order);
+}
+
+/// @brief reference version, one full scan per point O(n^2)
+/// @param points points to sort
+/// @param startIndex index of the first point
+void GeometryUtil::orderByNearestNeighbourLinear(TArrayView<FVector> points, int startIndex){
+    int count = points.Num();
+    if(count < 3 || startIndex < 0 || startIndex >= count){
+        return;
+    }
+
+    std::vector<bool> used(count, false);
+    std::vector<int> order;
+    order.reserve(count);
+    order.push_back(startIndex);
+    used[startIndex] = true;
+
+    int current = startIndex;
+    while(order.size() < count){
+        int best = -1;
+        float bestDistSquared = std::numeric_limits<float>::max();
+        for (int i = 0; i < count; i++){
+            if(!used[i]){
+                float distSquared = FVector::DistSquared(points[i], points[current]);
+                if(distSquared < bestDistSquared){
+                    bestDistSquared = distSquared;
+                    best = i;
+                }
+            }
+        }
+        if(best == -1){
+            break;
+        }
+        used[best] = true;
+        order.push_back(best);
+        current = best;
+    }
+
+    applyOrder(points, order);
+}
+
+void GeometryUtil::applyOrder(TArrayView<FVector> points, std::vector<int> &order){
+    std::vector<FVector> sorted;
+    sorted.reserve(order.size());
+    for (int i = 0; i < order.size(); i++){
+        sorted.push_back(points[order[i]]);
+    }
+    for (int i = 0; i < sorted.size(); i++){
+        points[i] = sorted[i];
+    }
+}
+
+
+
+
+/**
+ * 
+ * --- convex hull ---
+ * 
+ */
+
+/// @brief same predicate as GrahamScan, collinear points are removed
+bool GeometryUtil::isClockwise(const FVector &a, const FVector &b, const FVector &c){
+    return (b.X - a.X) * (c.Y - a.Y) - (b.Y - a.Y) * (c.X - a.X) < 0;
+}
+
+/// @brief computes the convex hull on the XY pane without moving the points,
+/// Z is ignored. O(n log n)
+/// @param points points to compute the hull for, stay untouched
+/// @param hullIndicesOut indices into points, hull order, cleared first
+/// @return count of hull points, 0 if less than 3 points were passed
+int GeometryUtil::convexHullXY(TArrayView<FVector> points, std::vector<int> &hullIndicesOut){
+    hullIndicesOut.clear();
+    int count = points.Num();
+    if(count < 3){
+        return 0;
+    }
+
+    std::vector<int> sorted(count);
+    for (int i = 0; i < count; i++){
+        sorted[i] = i;
+    }
+    std::sort(sorted.begin(), sorted.end(), [&points](int a, int b){
+        const FVector &pa = points[a];
+        const FVector &pb = points[b];
+        if(pa.X == pb.X){
+            return pa.Y < pb.Y;
+        }
+        return pa.X < pb.X;
+    });
+
+    std::vector<int> &hull = hullIndicesOut;
+    hull.reserve(count + 1);
+
+    //lower hull
+    for (int i = 0; i < count; i++){
+        const FVector &point = points[sorted[i]];
+        while(hull.size() >= 2 && !isClockwise(points[hull[hull.size() - 2]], points[hull.back()], point)){
+            hull.pop_back();
+        }
+        hull.push_back(sorted[i]);
+    }
+
+    //upper hull
+    int lowerHullCount = hull.size();
+    for (int i = count - 2; i >= 0; i--){
+        const FVector &point = points[sorted[i]];
+        while(hull.size() > lowerHullCount && !isClockwise(points[hull[hull.size() - 2]], points[hull.back()], point)){
+            hull.pop_back();
+        }
+        hull.push_back(sorted[i]);
+    }
+
+    //last point is the first one again
+    if(!hull.empty()){
+        hull.pop_back();
+    }
+    return hull.size();
+}
+
+
+
+
+/**
+ * 
+ * --- benchmark ---
+ * 
+ */
+
+/// @brief times the grid ordering and the index hull against the linear ordering and
+/// GrahamScan on the same random input, logs the times and if the results match
+/// @param pointCount points per set
+/// @param seed seed of the random point set
+void GeometryUtil::runBenchmark(int pointCount, int32 seed){
+    pointCount = std::max(3, pointCount);
+    FRandomStream random(seed);
+    std::vector<FVector> input;
+    input.reserve(pointCount);
+    for (int i = 0; i < pointCount; i++){
+        input.push_back(FVector(
+            random.FRandRange(-10000.0f, 10000.0f),
+            random.FRandRange(-10000.0f, 10000.0f),
+            random.FRandRange(-100.0f, 100.0f)
+        ));
+    }
+
+    //ordering
+    std::vector<FVector> linear = input;
+    double start = FPlatformTime::Seconds();
+    orderByNearestNeighbourLinear(MakeArrayView(linear.data(), linear.size()), 0);
+    double linearTime = FPlatformTime::Seconds() - start;
+
+    std::vector<FVector> grid = input;
+    start = FPlatformTime::Seconds();
+    orderByNearestNeighbour(MakeArrayView(grid.data(), grid.size()), 0);
+    double gridTime = FPlatformTime::Seconds() - start;
+
+    bool orderMatches = linear == grid;
+
+    //hull
+    std::vector<FVector> scanned = input;
+    start = FPlatformTime::Seconds();
+    GrahamScan scan;
+    scan.ComputeConvexHull(scanned);
+    double scanTime = FPlatformTime::Seconds() - start;
+
+    std::vector<int> hullIndices;
+    start = FPlatformTime::Seconds();
+    convexHullXY(MakeArrayView(input.data(), input.size()), hullIndices);
+    double hullTime = FPlatformTime::Seconds() - start;
+
+    bool hullMatches = scanned.size() == hullIndices.size();
+    for (int i = 0; hullMatches && i < hullIndices.size(); i++){
+        hullMatches = scanned[i] == input[hullIndices[i]];
+    }
+
+    FString message = FString::Printf(
+        TEXT("GeometryUtil benchmark points %d: order linear %.3f ms grid %.3f ms match %d, hull graham %.3f ms indexed %.3f ms match %d"),
+        pointCount,
+        linearTime * 1000.0,
+        gridTime * 1000.0,
+        orderMatches ? 1 : 0,
+        scanTime * 1000.0,
+        hullTime * 1000.0,
+        hullMatches ? 1 : 0
+    );
+    DebugHelper::logMessage(message);
+}
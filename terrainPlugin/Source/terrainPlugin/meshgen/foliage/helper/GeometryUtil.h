@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include <vector>
+
+/**
+ * point set helpers working on views (std::vector data can be passed with MakeArrayView).
+ * Nearest neighbour ordering uses a uniform grid on the XY pane, points are removed from
+ * their cell once used, so the ordering is close to linear for evenly spread shapes
+ * instead of one full scan per point.
+ * The hull is Andrews monotone chain on indices, same winding and start as GrahamScan.
+ */
+class TERRAINPLUGIN_API GeometryUtil
+{
+public:
+	static void orderByNearestNeighbour(TArrayView<FVector> points, int startIndex);
+	static void orderByNearestNeighbourLinear(TArrayView<FVector> points, int startIndex);
+
+	static int convexHullXY(TArrayView<FVector> points, std::vector<int> &hullIndicesOut);
+
+	static void runBenchmark(int pointCount, int32 seed);
+
+private:
+	GeometryUtil();
+	~GeometryUtil();
+
+	/// below this count a grid doesnt pay off
+	static const int LINEAR_LIMIT = 32;
+
+	static bool isClockwise(const FVector &a, const FVector &b, const FVector &c);
+	static void applyOrder(TArrayView<FVector> points, std::vector<int> &order);
+};
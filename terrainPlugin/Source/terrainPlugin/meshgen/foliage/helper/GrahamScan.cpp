@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "CoreMath/Matrix/MMatrix.h"
 #include "GrahamScan.h"
+#include "GeometryUtil.h"
 
 GrahamScan::GrahamScan()
 {
@@ -159,6 +160,11 @@ void GrahamScan::ComputeConvexHull(
         return;
     }
 
+    if(findEliminated){
+        ComputeConvexHullIndexed(points, eliminated);
+        return;
+    }
+
     // Sort points to calculate the lower hull
     //Z is up and ignored here.
     std::sort(points.begin(), points.end(), [](const FVector& a, const FVector& b) {
@@ -194,24 +200,34 @@ void GrahamScan::ComputeConvexHull(
         convexHull.pop_back();
     }
 
-    //identify eliminated points
-    if(findEliminated){
-        for (int i = 0; i < points.size(); i++){
-            FVector &current = points[i];
-            bool found = false;
-            for (int j = 0; j < convexHull.size(); j++)
-            {
-                if(convexHull[j] == current){
-                    found = true;
-                    break;
-                }
-            }
-            if(!found){
-                eliminated.push_back(current);
-            }
+    points.swap(convexHull);
+}
+
+
+/// @brief hull with eliminated points, the hull is computed on indices so the hull
+/// membership of each point is known without searching the hull for every point
+/// @param points points will be replaced with the convex hull of the passed points
+/// @param eliminated points not on the hull are appended here
+void GrahamScan::ComputeConvexHullIndexed(
+    std::vector<FVector> &points,
+    std::vector<FVector> &eliminated
+){
+    std::vector<int> hullIndices;
+    GeometryUtil::convexHullXY(MakeArrayView(points.data(), points.size()), hullIndices);
+
+    std::vector<bool> onHull(points.size(), false);
+    std::vector<FVector> convexHull;
+    convexHull.reserve(hullIndices.size());
+    for (int i = 0; i < hullIndices.size(); i++){
+        onHull[hullIndices[i]] = true;
+        convexHull.push_back(points[hullIndices[i]]);
+    }
+
+    for (int i = 0; i < points.size(); i++){
+        if(!onHull[i]){
+            eliminated.push_back(points[i]);
         }
     }
-    
 
-    points = convexHull;
-}
\ No newline at end of file
+    points.swap(convexHull);
+}
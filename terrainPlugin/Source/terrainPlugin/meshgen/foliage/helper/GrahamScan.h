@@ -30,4 +30,9 @@ public:
 
 private:
 	bool IsClockwise(const FVector &a, const FVector &b, const FVector &c);
+
+	void ComputeConvexHullIndexed(
+		std::vector<FVector> &points,
+		std::vector<FVector> &eliminated
+	);
 };
@@ -4,6 +4,7 @@
 #include "ParallellShapeMerger.h"
 #include <algorithm>
 #include "GrahamScan.h"
+#include "GeometryUtil.h"
 #include "GameCore/util/FVectorUtil.h"
 #include <limits>
 
@@ -145,137 +146,85 @@ void ParallellShapeMerger::sortPointsByDistance(
         return;
     }
 
-    std::vector<FVector> output;
-    std::vector<bool> wasPushed(points.size(), false);
-    FVector prevPoint = startingPoint;
-
-    //find starting point if was part of sorted array
-    for (int i = 0; i < points.size(); i++){
-        if(points[i] == startingPoint){
-            wasPushed[i] = true;
-            output.push_back(startingPoint);
-            break;
+    //start at the starting point or the closest point to it if not part of the set
+    int startIndex = findClosestIndexTo(points, 0, startingPoint);
+    std::swap(points[0], points[startIndex]);
+    int fixedCount = 1;
+
+    //CHECK DIR ON START, only if a direction is given
+    if(!isSame(startingPoint, nextToStartingPoint)){
+        FVector dir = nextToStartingPoint - startingPoint; //AB = B - A
+        int nextIndex = findClosestIndexToAndMatchDirection(points, 1, points[0], dir);
+        if(nextIndex != errorValue){
+            std::swap(points[1], points[nextIndex]);
+            fixedCount = 2;
         }
     }
 
-    bool checkDir = false;
-    FVector dir;
-    if(isSame(startingPoint, nextToStartingPoint)){
-        dir = nextToStartingPoint - startingPoint; //AB = B - A
-        checkDir = true;
-    }
-
-    //start sorting until output vector is full, then override 
-    while(output.size() < points.size()){
-        FVector found;
-
-        if(output.size() == 1 && checkDir){
-            //CHECK DIR ON START
-            if(findClosestPointToAndMatchDirection(
-                points,
-                wasPushed,
-                prevPoint,
-                found,
-                dir
-            )){
-                output.push_back(found);
-                prevPoint = found;
-                checkDir = false;
-            }
-        }else{
-            //DEFAULT SEARCH
-            if (findClosestPointTo(
-                    points,
-                    wasPushed,
-                    prevPoint,
-                    found
-            )){
-                output.push_back(found);
-                prevPoint = found; 
-            }
-        }
-    }
-    //override
-    points = output;
+    //remaining points by distance, the last fixed point is the start of the view
+    int offset = fixedCount - 1;
+    GeometryUtil::orderByNearestNeighbour(
+        MakeArrayView(points.data() + offset, points.size() - offset),
+        0
+    );
 }
 
 bool ParallellShapeMerger::isSame(FVector &a, FVector &b){
     return std::abs(FVector::Dist(a, b)) < 1.0f;
 }
 
-bool ParallellShapeMerger::findClosestPointTo(
+/// @brief finds the closest point, only indices from "from" on are searched
+/// @return index or errorValue
+int ParallellShapeMerger::findClosestIndexTo(
     std::vector<FVector> &points,
-    std::vector<bool> &usedIndices,
-    FVector &closestPointSearchedFor,
-    FVector &outpoint
+    int from,
+    FVector &closestPointSearchedFor
 ){
-    if(points.size() <= 0){
-        return false;
-    }
-
-    int index = 0;
-    FVector closestPoint;
+    int index = errorValue;
     float closestDist = std::numeric_limits<float>::max();
 
-    for (int i = 1; i < points.size(); i++)
+    for (int i = from; i < points.size(); i++)
     {
-        if(usedIndices[i] == false){
-            FVector &currentPoint = points[i];
-            float newdist = FVector::Dist(currentPoint, closestPointSearchedFor);
-            if(newdist < closestDist){
-                closestDist = newdist;
-                closestPoint = currentPoint;
-                index = i;
-            }
+        float newdist = FVector::Dist(points[i], closestPointSearchedFor);
+        if(newdist < closestDist){
+            closestDist = newdist;
+            index = i;
         }
     }
-    usedIndices[index] = true; //copy out
-    outpoint = closestPoint; //copy out
-    return true;
+    return index;
 }
 
 
 
-
-bool ParallellShapeMerger::findClosestPointToAndMatchDirection(
+/// @brief finds the closest point in the given direction, only indices from "from" on are searched
+/// @return index or errorValue
+int ParallellShapeMerger::findClosestIndexToAndMatchDirection(
     std::vector<FVector> &points,
-    std::vector<bool> &usedIndices,
+    int from,
     FVector &closestPointSearchedFor,
-    FVector &outpoint,
     FVector &directionToMatch
 ){
-    if(points.size() <= 0){
-        return false;
-    }
-    directionToMatch = directionToMatch.GetSafeNormal();
+    FVector direction = directionToMatch.GetSafeNormal();
 
-    int index = 0;
-    FVector closestPoint;
+    int index = errorValue;
     float closestDist = std::numeric_limits<float>::max();
 
-    for (int i = 1; i < points.size(); i++)
+    for (int i = from; i < points.size(); i++)
     {
-        if(usedIndices[i] == false){
-            FVector &currentPoint = points[i];
-            FVector connectCompare = currentPoint - closestPointSearchedFor; //AB = B - A
-            connectCompare = connectCompare.GetSafeNormal();
-            float dot = FVector::DotProduct(
-                directionToMatch,
-                connectCompare
-            );
-            if(dot > 0.0f){
-                float newdist = FVector::Dist(currentPoint, closestPointSearchedFor);
-                if(newdist < closestDist){
-                    closestDist = newdist;
-                    closestPoint = currentPoint;
-                    index = i;
-                }
+        FVector &currentPoint = points[i];
+        FVector connectCompare = currentPoint - closestPointSearchedFor; //AB = B - A
+        connectCompare = connectCompare.GetSafeNormal();
+        float dot = FVector::DotProduct(
+            direction,
+            connectCompare
+        );
+        if(dot > 0.0f){
+            float newdist = FVector::Dist(currentPoint, closestPointSearchedFor);
+            if(newdist < closestDist){
+                closestDist = newdist;
+                index = i;
             }
-
-            
         }
     }
-    usedIndices[index] = true; //copy out
-    outpoint = closestPoint; //copy out
-    return true;
-}
\ No newline at end of file
+    return index;
+}
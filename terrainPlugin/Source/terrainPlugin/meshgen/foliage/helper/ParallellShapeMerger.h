@@ -57,18 +57,16 @@ private:
 		FVector nextToStartingPoint
 	);
 
-	bool findClosestPointTo(
+	int findClosestIndexTo(
 		std::vector<FVector> &points,
-		std::vector<bool> &usedIndices,
-		FVector &other,
-		FVector &outpoint
+		int from,
+		FVector &closestPointSearchedFor
 	);
 
-	bool findClosestPointToAndMatchDirection(
+	int findClosestIndexToAndMatchDirection(
 		std::vector<FVector> &points,
-		std::vector<bool> &usedIndices,
+		int from,
 		FVector &closestPointSearchedFor,
-		FVector &outpoint,
 		FVector &directionToMatch
 	);
 };
\ No newline at end of file
@@ -0,0 +1,18 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ShapeArena.h"
+
+ShapeArena::ShapeArena()
+{
+}
+
+ShapeArena::~ShapeArena()
+{
+}
+
+/// @brief clears all buffers, the capacity is kept
+void ShapeArena::reset(){
+    vertecies.clear();
+    ring.clear();
+}
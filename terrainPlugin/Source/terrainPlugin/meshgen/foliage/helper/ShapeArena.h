@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "terrainPlugin/meshgen/generation/bezierCurve.h"
+#include <vector>
+
+/**
+ * caller owned scratch memory for FVectorShape processing.
+ * Keep one arena alive per generator (or per job when running in parallel), all buffers
+ * are only cleared between uses and keep their capacity, so smoothing and ring creation
+ * dont allocate anymore once the arena is warmed up.
+ * Not thread safe, never share one arena between threads.
+ */
+class TERRAINPLUGIN_API ShapeArena
+{
+public:
+	ShapeArena();
+	~ShapeArena();
+
+	void reset();
+
+	/// @brief curve with reused anchor and interpolation buffers
+	bezierCurve curve;
+
+	/// @brief output of the bezier smoothing, swapped with the shape vertecies afterwards
+	std::vector<FVector> vertecies;
+
+	/// @brief one transformed ring, used for sphere creation
+	std::vector<FVector> ring;
+};
@@ -0,0 +1,213 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "StemRingTemplate.h"
+
+StemRingTemplate::StemRingTemplate()
+{
+}
+
+/// @brief creates the template from the stem shapes of a tree type, all shapes must
+/// have the same vertex count, otherwise the template stays invalid
+/// @param profiles stem shapes, emitted in this order per matrix
+StemRingTemplate::StemRingTemplate(std::vector<FVectorShape> &profiles)
+{
+    if(profiles.size() == 0){
+        return;
+    }
+    int size = profiles[0].vertexCount();
+    if(size < 3){
+        return;
+    }
+    for (int i = 1; i < profiles.size(); i++){
+        if(profiles[i].vertexCount() != size){
+            return;
+        }
+    }
+
+    ringSize = size;
+    ringStride = ((size + LANES - 1) / LANES) * LANES;
+    ringCount = profiles.size();
+
+    xs.SetNumZeroed(ringStride * ringCount);
+    ys.SetNumZeroed(ringStride * ringCount);
+    zs.SetNumZeroed(ringStride * ringCount);
+
+    for (int i = 0; i < ringCount; i++){
+        std::vector<FVector> &vertecies = profiles[i].vectorRef();
+        FVector center(0, 0, 0);
+        for (int j = 0; j < vertecies.size(); j++){
+            center += vertecies[j];
+        }
+        center /= vertecies.size();
+        ringCenters.Add(center);
+
+        int offset = i * ringStride;
+        for (int j = 0; j < vertecies.size(); j++){
+            FVector local = vertecies[j] - center;
+            xs[offset + j] = local.X;
+            ys[offset + j] = local.Y;
+            zs[offset + j] = local.Z;
+        }
+    }
+
+    buildPatterns();
+}
+
+StemRingTemplate::StemRingTemplate(const StemRingTemplate &other){
+    *this = other;
+}
+
+StemRingTemplate &StemRingTemplate::operator=(const StemRingTemplate &other){
+    if(this == &other){
+        return *this;
+    }
+    ringSize = other.ringSize;
+    ringStride = other.ringStride;
+    ringCount = other.ringCount;
+    xs = other.xs;
+    ys = other.ys;
+    zs = other.zs;
+    ringCenters = other.ringCenters;
+    stitchPattern = other.stitchPattern;
+    capPattern = other.capPattern;
+    return *this;
+}
+
+StemRingTemplate::~StemRingTemplate()
+{
+}
+
+bool StemRingTemplate::isValid(){
+    return ringCount > 0;
+}
+
+int StemRingTemplate::resolution(){
+    return ringSize;
+}
+
+int StemRingTemplate::ringsPerMatrix(){
+    return ringCount;
+}
+
+/// @brief same winding as MeshData::appendVertecies and MeshData::closeMeshAtCenter,
+/// the cap fans from the center vertex instead of the first ring vertex
+void StemRingTemplate::buildPatterns(){
+    stitchPattern.Empty();
+    capPattern.Empty();
+    stitchPattern.Reserve(ringSize * 6);
+    capPattern.Reserve(ringSize * 3);
+
+    for (int i = 0; i < ringSize; i++){
+        int next = (i + 1) % ringSize;
+        /*
+        1 2
+        0 3
+        */
+        stitchPattern.Add(i); //lower(0)
+        stitchPattern.Add(next); //lower(3)
+        stitchPattern.Add(ringSize + i); //upper(1)
+
+        stitchPattern.Add(next); //lower (3)
+        stitchPattern.Add(ringSize + next); //upper(2)
+        stitchPattern.Add(ringSize + i); //upper (1)
+
+        capPattern.Add(ringSize); //center
+        capPattern.Add(i);
+        capPattern.Add(next);
+    }
+}
+
+/// @brief emits the stem of one chain: every ring is scaled around its pivot, moved with
+/// the chain matrix, stitched to the ring before and the last ring is closed on top
+/// @param matrices chain matrices, one set of rings per matrix
+/// @param ringScale scale matrix of the recursion level (diagonal, no translation)
+/// @param output mesh to append to, normals are calculated for the new part
+/// @param lastRingOutput top ring vertecies as translation matrices, appended
+void StemRingTemplate::emit(
+    std::vector<MMatrix> &matrices,
+    MMatrix &ringScale,
+    MeshData &output,
+    std::vector<MMatrix> &lastRingOutput
+){
+    if(!isValid() || matrices.size() < 2){
+        return;
+    }
+
+    int totalRings = matrices.size() * ringCount;
+    TArray<FVector> vertecies;
+    TArray<int32> triangles;
+    vertecies.Reserve(totalRings * ringSize + ringSize + 1);
+    triangles.Reserve((totalRings - 1) * stitchPattern.Num() + capPattern.Num());
+
+    float sx = ringScale.get(0, 0);
+    float sy = ringScale.get(1, 1);
+    float sz = ringScale.get(2, 2);
+
+    for (int i = 0; i < matrices.size(); i++){
+        MMatrix &matrix = matrices[i];
+        for (int ring = 0; ring < ringCount; ring++){
+            //scale around pivot and move: M * (S * local + center), as one 3x4 affine
+            FVector &center = ringCenters[ring];
+            float affine[12];
+            for (int row = 0; row < 3; row++){
+                float m0 = matrix.get(0, row);
+                float m1 = matrix.get(1, row);
+                float m2 = matrix.get(2, row);
+                affine[row * 4] = m0 * sx;
+                affine[row * 4 + 1] = m1 * sy;
+                affine[row * 4 + 2] = m2 * sz;
+                affine[row * 4 + 3] = m0 * center.X + m1 * center.Y + m2 * center.Z
+                    + matrix.get(3, row);
+            }
+
+            int ringOffset = vertecies.Num();
+            emitRing(ring, affine, vertecies);
+
+            if(ringOffset > 0){
+                int previous = ringOffset - ringSize;
+                for (int j = 0; j < stitchPattern.Num(); j++){
+                    triangles.Add(previous + stitchPattern[j]);
+                }
+            }
+        }
+    }
+
+    //close top: copy of the last ring and its center
+    int lastRing = vertecies.Num() - ringSize;
+    int capOffset = vertecies.Num();
+    FVector capCenter(0, 0, 0);
+    for (int i = 0; i < ringSize; i++){
+        FVector current = vertecies[lastRing + i];
+        capCenter += current;
+        vertecies.Add(current);
+
+        MMatrix top;
+        top.setTranslation(current);
+        lastRingOutput.push_back(top);
+    }
+    capCenter /= ringSize;
+    vertecies.Add(capCenter);
+    for (int i = 0; i < capPattern.Num(); i++){
+        triangles.Add(capOffset + capPattern[i]);
+    }
+
+    MeshData subMesh(MoveTemp(vertecies), MoveTemp(triangles));
+    subMesh.calculateNormals();
+    output.append(subMesh);
+}
+
+void StemRingTemplate::emitRing(int ring, float *affine, TArray<FVector> &vertecies){
+    int offset = ring * ringStride;
+    const float *x = xs.GetData() + offset;
+    const float *y = ys.GetData() + offset;
+    const float *z = zs.GetData() + offset;
+
+    for (int i = 0; i < ringSize; i++){
+        vertecies.Add(FVector(
+            affine[0] * x[i] + affine[1] * y[i] + affine[2] * z[i] + affine[3],
+            affine[4] * x[i] + affine[5] * y[i] + affine[6] * z[i] + affine[7],
+            affine[8] * x[i] + affine[9] * y[i] + affine[10] * z[i] + affine[11]
+        ));
+    }
+}
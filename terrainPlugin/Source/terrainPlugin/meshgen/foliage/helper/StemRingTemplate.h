@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "CoreMath/Matrix/MMatrix.h"
+#include "GameCore/MeshGenBase/MeshData/MeshData.h"
+#include "terrainPlugin/meshgen/foliage/helper/FVectorShape.h"
+#include <vector>
+
+/**
+ * precomputed ring profile of a stem type, created once and never changed afterwards.
+ * The rings are stored centered around their pivot in 16 byte aligned arrays (each ring
+ * padded to a multiple of 4), the ring to ring stitching and the top cap are fixed index
+ * patterns. Wrapping a chain is one linear transform and emit pass, nothing is welded.
+ */
+class TERRAINPLUGIN_API StemRingTemplate
+{
+public:
+	StemRingTemplate();
+	StemRingTemplate(std::vector<FVectorShape> &profiles);
+	StemRingTemplate(const StemRingTemplate &other);
+	StemRingTemplate &operator=(const StemRingTemplate &other);
+	~StemRingTemplate();
+
+	static const int LANES = 4;
+
+	bool isValid();
+	int resolution();
+	int ringsPerMatrix();
+
+	void emit(
+		std::vector<MMatrix> &matrices,
+		MMatrix &ringScale,
+		MeshData &output,
+		std::vector<MMatrix> &lastRingOutput
+	);
+
+private:
+	/// @brief vertecies per ring, same for all rings
+	int ringSize = 0;
+	/// @brief ring size padded to LANES
+	int ringStride = 0;
+	int ringCount = 0;
+
+	TArray<float, TAlignedHeapAllocator<16>> xs;
+	TArray<float, TAlignedHeapAllocator<16>> ys;
+	TArray<float, TAlignedHeapAllocator<16>> zs;
+
+	/// @brief pivot of each ring, the recursion scale is applied around it
+	TArray<FVector> ringCenters;
+
+	/// @brief previous ring at 0, current ring at ringSize
+	TArray<int32> stitchPattern;
+	/// @brief cap ring copy at 0, triangles fan from the center at ringSize
+	TArray<int32> capPattern;
+
+	void buildPatterns();
+	void emitRing(int ring, float *affine, TArray<FVector> &vertecies);
+};
@@ -128,6 +128,27 @@ int TreeProperties::subTreeCount(){
     return 0;
 }
 
+/// @brief same as partsPerSubtree() but drawn from the passed stream (deterministic)
+int TreeProperties::partsPerSubtree(FRandomStream &random){
+    if(partsPerSubtreeSaved <= 4){
+        return partsPerSubtreeSaved;
+    }
+    int half = partsPerSubtreeSaved / 2;
+    return random.RandRange(half, partsPerSubtreeSaved);
+}
+
+/// @brief same as subTreeCount() but drawn from the passed stream (deterministic)
+int TreeProperties::subTreeCount(FRandomStream &random){
+    if(subTreeCountSaved <= 0){
+        return 0;
+    }
+    int rand = random.RandRange(0, subTreeCountSaved - 1);
+    if(rand != 1){
+        return rand;
+    }
+    return 0;
+}
+
 void TreeProperties::setRecursionLevelMax(int count){
     recursionLevelInternal = std::abs(count);
     if(recursionLevelInternal < 1){
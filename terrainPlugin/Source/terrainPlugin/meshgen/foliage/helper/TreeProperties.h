@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Math/RandomStream.h"
 #include "terrainPlugin/meshgen/foliage/ETreeType.h"
 #include "AssetPlugin/gamestart/assetEnums/materialEnum.h"
 #include "GameCore/MeshGenBase/foliage/ETerrainType.h"
@@ -37,8 +38,10 @@ public:
 
 	int leafCountPerJoint();
 	int partsPerSubtree();
+	int partsPerSubtree(FRandomStream &random);
 
 	int subTreeCount();
+	int subTreeCount(FRandomStream &random);
 
 	void setRecursionLevelMax(int count);
 	int resursionLevelMax();
@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ImpostorAtlas.h"
+
+ImpostorAtlas::ImpostorAtlas()
+{
+}
+
+ImpostorAtlas::ImpostorAtlas(const ImpostorAtlas &other){
+    *this = other;
+}
+
+ImpostorAtlas &ImpostorAtlas::operator=(const ImpostorAtlas &other){
+    if(this == &other){
+        return *this;
+    }
+    views = other.views;
+    size = other.size;
+    halfWidth = other.halfWidth;
+    bottom = other.bottom;
+    quadHeightCm = other.quadHeightCm;
+    pixels = other.pixels;
+    return *this;
+}
+
+ImpostorAtlas::~ImpostorAtlas()
+{
+}
+
+/// @brief allocates the atlas, all pixels transparent
+/// @param viewCountIn views around the z axis
+/// @param viewSizeIn pixels per view on x and y
+/// @param halfWidthIn half width of the quad in cm
+/// @param bottomIn lowest z of the quad in cm
+/// @param heightIn height of the quad in cm
+void ImpostorAtlas::init(int viewCountIn, int viewSizeIn, float halfWidthIn, float bottomIn, float heightIn){
+    views = std::max(1, viewCountIn);
+    size = std::max(1, viewSizeIn);
+    halfWidth = halfWidthIn;
+    bottom = bottomIn;
+    quadHeightCm = heightIn;
+    pixels.Init(FColor(0, 0, 0, 0), width() * height());
+}
+
+bool ImpostorAtlas::isValid(){
+    return pixels.Num() > 0 && halfWidth > 0.0f && quadHeightCm > 0.0f;
+}
+
+int ImpostorAtlas::viewCount(){
+    return views;
+}
+
+int ImpostorAtlas::viewSize(){
+    return size;
+}
+
+int ImpostorAtlas::width(){
+    return views * size;
+}
+
+int ImpostorAtlas::height(){
+    return size;
+}
+
+float ImpostorAtlas::quadHalfWidth(){
+    return halfWidth;
+}
+
+float ImpostorAtlas::quadBottom(){
+    return bottom;
+}
+
+float ImpostorAtlas::quadHeight(){
+    return quadHeightCm;
+}
+
+float ImpostorAtlas::viewYawDegree(int view){
+    return (360.0f / views) * view;
+}
+
+/// @brief pixel of a view, y = 0 is the top row
+FColor &ImpostorAtlas::pixel(int view, int x, int y){
+    if(view < 0 || view >= views || x < 0 || x >= size || y < 0 || y >= size){
+        return outOfRange;
+    }
+    return pixels[y * width() + view * size + x];
+}
+
+TArray<FColor> &ImpostorAtlas::pixelsByReference(){
+    return pixels;
+}
+
+/// @brief uv rect of a view inside the atlas
+void ImpostorAtlas::uvRectForView(int view, FVector2D &uvMin, FVector2D &uvMax){
+    float part = 1.0f / views;
+    uvMin = FVector2D(part * view, 0.0f);
+    uvMax = FVector2D(part * (view + 1), 1.0f);
+}
+
+/// @brief count of pixels any triangle was drawn to, 0 means the bake failed
+int ImpostorAtlas::coveredPixelCount(){
+    int count = 0;
+    for (int i = 0; i < pixels.Num(); i++){
+        if(pixels[i].A > 0){
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * cpu side impostor texture of one tree variant: viewCount views around the z axis,
+ * next to each other in one row. View i is seen from yaw i * 360 / viewCount.
+ * Uncovered pixels have alpha 0. Pure data, created by the ImpostorBaker.
+ */
+class TERRAINPLUGIN_API ImpostorAtlas
+{
+public:
+	ImpostorAtlas();
+	ImpostorAtlas(const ImpostorAtlas &other);
+	ImpostorAtlas &operator=(const ImpostorAtlas &other);
+	~ImpostorAtlas();
+
+	void init(int viewCountIn, int viewSizeIn, float halfWidthIn, float bottomIn, float heightIn);
+
+	bool isValid();
+
+	int viewCount();
+	int viewSize();
+	int width();
+	int height();
+
+	float quadHalfWidth();
+	float quadBottom();
+	float quadHeight();
+	float viewYawDegree(int view);
+
+	FColor &pixel(int view, int x, int y);
+	TArray<FColor> &pixelsByReference();
+
+	void uvRectForView(int view, FVector2D &uvMin, FVector2D &uvMax);
+	int coveredPixelCount();
+
+private:
+	int views = 0;
+	int size = 0;
+
+	/// @brief world size of the quad in cm, the pivot is the bottom center
+	float halfWidth = 0.0f;
+	float bottom = 0.0f;
+	float quadHeightCm = 0.0f;
+
+	TArray<FColor> pixels;
+	FColor outOfRange;
+};
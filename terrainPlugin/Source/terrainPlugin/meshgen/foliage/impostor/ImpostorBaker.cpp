@@ -0,0 +1,263 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ImpostorBaker.h"
+
+ImpostorBaker::ImpostorBaker()
+{
+}
+
+ImpostorBaker::~ImpostorBaker()
+{
+}
+
+/**
+ * 
+ * --- bake ---
+ * 
+ */
+
+/// @brief renders all views of the variant, the quad size is the same for all views:
+/// max distance to the z axis and the z extent of both meshes
+/// @param stem stem mesh, local, pivot at the root
+/// @param leaf leaf mesh, local, pivot at the root
+/// @param output atlas to write, reinitialized
+void ImpostorBaker::bake(MeshData &stem, MeshData &leaf, ImpostorAtlas &output){
+    std::vector<MeshData *> meshes = {&stem, &leaf};
+
+    float halfWidth = 0.0f;
+    float zMin = 0.0f;
+    float zMax = 0.0f;
+    bool first = true;
+    for (int i = 0; i < meshes.size(); i++){
+        TArray<FVector> &vertecies = meshes[i]->getVerteciesRef();
+        for (int j = 0; j < vertecies.Num(); j++){
+            FVector &current = vertecies[j];
+            halfWidth = std::max(halfWidth, (float) FVector2D(current.X, current.Y).Size());
+            if(first){
+                zMin = current.Z;
+                zMax = current.Z;
+                first = false;
+            }
+            zMin = std::min(zMin, (float) current.Z);
+            zMax = std::max(zMax, (float) current.Z);
+        }
+    }
+
+    output.init(VIEW_COUNT, VIEW_SIZE, halfWidth, zMin, zMax - zMin);
+    if(!output.isValid()){
+        return;
+    }
+
+    std::vector<float> depth;
+    for (int view = 0; view < VIEW_COUNT; view++){
+        depth.assign(VIEW_SIZE * VIEW_SIZE, -FLT_MAX);
+        bakeView(meshes, view, output, depth);
+    }
+}
+
+void ImpostorBaker::bakeView(
+    std::vector<MeshData *> &meshes,
+    int view,
+    ImpostorAtlas &output,
+    std::vector<float> &depth
+){
+    float yaw = output.viewYawDegree(view);
+    for (int i = 0; i < meshes.size(); i++){
+        MeshData &mesh = *meshes[i];
+        TArray<FVector> &vertecies = mesh.getVerteciesRef();
+        TArray<int32> &triangles = mesh.getTrianglesRef();
+        FColor base = baseColorFor(mesh.targetMaterial());
+
+        for (int j = 2; j < triangles.Num(); j += 3){
+            int32 i0 = triangles[j - 2];
+            int32 i1 = triangles[j - 1];
+            int32 i2 = triangles[j];
+            if(!vertecies.IsValidIndex(i0) || !vertecies.IsValidIndex(i1) || !vertecies.IsValidIndex(i2)){
+                continue;
+            }
+
+            //leafs are thin double sided planes, shade independent of the facing
+            FVector normal = FVector::CrossProduct(
+                vertecies[i1] - vertecies[i0],
+                vertecies[i2] - vertecies[i0]
+            ).GetSafeNormal();
+            FColor color = shade(base, normal);
+
+            FVector a = toViewSpace(vertecies[i0], yaw, output);
+            FVector b = toViewSpace(vertecies[i1], yaw, output);
+            FVector c = toViewSpace(vertecies[i2], yaw, output);
+            rasterizeTriangle(a, b, c, color, view, output, depth);
+        }
+    }
+}
+
+/// @brief view space of a view: x, y in pixels (y = 0 top), z is the depth, bigger is closer.
+/// The camera looks from (cos yaw, sin yaw, 0) to the z axis, screen right is
+/// (-sin yaw, cos yaw, 0) which is the same axis the impostor quad uses
+FVector ImpostorBaker::toViewSpace(FVector &vertex, float yawDegree, ImpostorAtlas &atlas){
+    float yaw = FMath::DegreesToRadians(yawDegree);
+    float cos = std::cos(yaw);
+    float sin = std::sin(yaw);
+
+    float right = -sin * vertex.X + cos * vertex.Y;
+    float towardsCamera = cos * vertex.X + sin * vertex.Y;
+
+    float size = atlas.viewSize();
+    float x = (right + atlas.quadHalfWidth()) / (2.0f * atlas.quadHalfWidth()) * size;
+    float y = (1.0f - (vertex.Z - atlas.quadBottom()) / atlas.quadHeight()) * size;
+    return FVector(x, y, towardsCamera);
+}
+
+/// @brief z buffered barycentric rasterization, pixel centers are sampled
+void ImpostorBaker::rasterizeTriangle(
+    FVector &a,
+    FVector &b,
+    FVector &c,
+    FColor color,
+    int view,
+    ImpostorAtlas &output,
+    std::vector<float> &depth
+){
+    float area = (b.X - a.X) * (c.Y - a.Y) - (b.Y - a.Y) * (c.X - a.X);
+    if(std::abs(area) < 0.0001f){
+        return;
+    }
+
+    int size = output.viewSize();
+    int minX = std::max(0, (int) std::floor(std::min(a.X, std::min(b.X, c.X))));
+    int maxX = std::min(size - 1, (int) std::ceil(std::max(a.X, std::max(b.X, c.X))));
+    int minY = std::max(0, (int) std::floor(std::min(a.Y, std::min(b.Y, c.Y))));
+    int maxY = std::min(size - 1, (int) std::ceil(std::max(a.Y, std::max(b.Y, c.Y))));
+
+    for (int y = minY; y <= maxY; y++){
+        for (int x = minX; x <= maxX; x++){
+            float px = x + 0.5f;
+            float py = y + 0.5f;
+
+            float w0 = ((b.X - px) * (c.Y - py) - (b.Y - py) * (c.X - px)) / area;
+            float w1 = ((c.X - px) * (a.Y - py) - (c.Y - py) * (a.X - px)) / area;
+            float w2 = 1.0f - w0 - w1;
+            if(w0 < 0.0f || w1 < 0.0f || w2 < 0.0f){
+                continue;
+            }
+
+            float z = w0 * a.Z + w1 * b.Z + w2 * c.Z;
+            float &stored = depth[y * size + x];
+            if(z > stored){
+                stored = z;
+                output.pixel(view, x, y) = color;
+            }
+        }
+    }
+}
+
+FColor ImpostorBaker::baseColorFor(materialEnum material){
+    if(material == materialEnum::treeMaterial){
+        return FColor(92, 64, 40, 255);
+    }
+    if(material == materialEnum::palmLeafMaterial){
+        return FColor(62, 118, 42, 255);
+    }
+    return FColor(128, 128, 128, 255);
+}
+
+/// @brief flat lambert from a fixed sun direction, never fully dark
+FColor ImpostorBaker::shade(FColor base, FVector &normal){
+    FVector sun = FVector(0.4f, 0.3f, 1.0f).GetSafeNormal();
+    float light = 0.45f + 0.55f * std::abs(FVector::DotProduct(normal, sun));
+    return FColor(
+        (uint8) (base.R * light),
+        (uint8) (base.G * light),
+        (uint8) (base.B * light),
+        255
+    );
+}
+
+
+/**
+ * 
+ * --- impostor mesh ---
+ * 
+ */
+
+/// @brief creates VIEW_COUNT / 2 crossed quads through the z axis. The front of quad i
+/// faces view i, the back faces view i + VIEW_COUNT / 2 (mirrored uvs), uvs point into
+/// the atlas. Target material is the leaf material
+/// @param atlas baked atlas
+/// @return mesh with uvs and normals, empty if the atlas is invalid
+MeshData ImpostorBaker::createImpostorMesh(ImpostorAtlas &atlas){
+    MeshData output;
+    if(!atlas.isValid()){
+        return output;
+    }
+
+    TArray<FVector> vertecies;
+    TArray<int32> triangles;
+    TArray<FVector2D> uvs;
+
+    int views = atlas.viewCount();
+    int half = views / 2;
+    float halfWidth = atlas.quadHalfWidth();
+    FVector up(0, 0, atlas.quadHeight());
+    FVector base(0, 0, atlas.quadBottom());
+
+    for (int i = 0; i < half; i++){
+        float yaw = FMath::DegreesToRadians(atlas.viewYawDegree(i));
+        FVector right(-std::sin(yaw), std::cos(yaw), 0.0f);
+
+        FVector bottomLeft = base - right * halfWidth;
+        FVector bottomRight = base + right * halfWidth;
+        FVector topLeft = bottomLeft + up;
+        FVector topRight = bottomRight + up;
+
+        for (int side = 0; side < 2; side++){
+            int view = i + side * half;
+            FVector2D uvMin;
+            FVector2D uvMax;
+            atlas.uvRectForView(view, uvMin, uvMax);
+
+            //back side: screen right is -right, u is mirrored
+            float uLeft = side == 0 ? uvMin.X : uvMax.X;
+            float uRight = side == 0 ? uvMax.X : uvMin.X;
+
+            int offset = vertecies.Num();
+            vertecies.Add(bottomLeft);
+            vertecies.Add(topLeft);
+            vertecies.Add(topRight);
+            vertecies.Add(bottomRight);
+            uvs.Add(FVector2D(uLeft, uvMax.Y));
+            uvs.Add(FVector2D(uLeft, uvMin.Y));
+            uvs.Add(FVector2D(uRight, uvMin.Y));
+            uvs.Add(FVector2D(uRight, uvMax.Y));
+
+            /*
+            1 2
+            0 3
+            */
+            if(side == 0){
+                //normal towards the camera of view i
+                triangles.Add(offset);
+                triangles.Add(offset + 3);
+                triangles.Add(offset + 2);
+                triangles.Add(offset);
+                triangles.Add(offset + 2);
+                triangles.Add(offset + 1);
+            }else{
+                triangles.Add(offset);
+                triangles.Add(offset + 1);
+                triangles.Add(offset + 2);
+                triangles.Add(offset);
+                triangles.Add(offset + 2);
+                triangles.Add(offset + 3);
+            }
+        }
+    }
+
+    output.setVertecies(MoveTemp(vertecies));
+    output.setTriangles(MoveTemp(triangles));
+    output.getUV0Ref() = uvs;
+    output.calculateNormals();
+    output.setTargetMaterial(materialEnum::palmLeafMaterial);
+    return output;
+}
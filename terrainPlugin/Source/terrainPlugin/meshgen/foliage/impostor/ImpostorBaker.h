@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameCore/MeshGenBase/MeshData/MeshData.h"
+#include "terrainPlugin/meshgen/foliage/impostor/ImpostorAtlas.h"
+#include "AssetPlugin/gamestart/assetEnums/materialEnum.h"
+#include <vector>
+
+/**
+ * renders a tree variant into an ImpostorAtlas on the cpu (orthographic views around the
+ * z axis, z buffered triangles, flat lambert shading) and creates the matching impostor
+ * mesh: VIEW_COUNT / 2 crossed vertical quads, each side shows the view facing it.
+ * Needs no gpu and no world, can be used headless.
+ */
+class TERRAINPLUGIN_API ImpostorBaker
+{
+public:
+	ImpostorBaker();
+	~ImpostorBaker();
+
+	/// @brief must be even, opposite views share one quad
+	static const int VIEW_COUNT = 8;
+	static const int VIEW_SIZE = 64;
+
+	void bake(MeshData &stem, MeshData &leaf, ImpostorAtlas &output);
+	MeshData createImpostorMesh(ImpostorAtlas &atlas);
+
+private:
+	void bakeView(
+		std::vector<MeshData *> &meshes,
+		int view,
+		ImpostorAtlas &output,
+		std::vector<float> &depth
+	);
+	void rasterizeTriangle(
+		FVector &a,
+		FVector &b,
+		FVector &c,
+		FColor color,
+		int view,
+		ImpostorAtlas &output,
+		std::vector<float> &depth
+	);
+
+	FVector toViewSpace(FVector &vertex, float yawDegree, ImpostorAtlas &atlas);
+	FColor baseColorFor(materialEnum material);
+	FColor shade(FColor base, FVector &normal);
+};
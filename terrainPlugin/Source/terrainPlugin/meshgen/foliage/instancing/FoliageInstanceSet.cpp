@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FoliageInstanceSet.h"
+#include "terrainPlugin/meshgen/foliage/instancing/FoliageMeshRegistry.h"
+#include "GameCore/DebugHelper.h"
+
+FoliageInstanceSet::FoliageInstanceSet()
+{
+}
+
+FoliageInstanceSet::~FoliageInstanceSet()
+{
+    clear();
+}
+
+void FoliageInstanceSet::clear(){
+    instancesByVariant.clear();
+    instanceCountSaved = 0;
+}
+
+/// @brief adds an instance of a shared variant
+/// @param variantId id from the FoliageMeshRegistry
+/// @param transform transform of the instance (world space)
+void FoliageInstanceSet::addInstance(int variantId, FTransform &transform){
+    instancesByVariant[variantId].Add(transform);
+    instanceCountSaved++;
+}
+
+std::map<int, TArray<FTransform>> &FoliageInstanceSet::instancesByVariantRef(){
+    return instancesByVariant;
+}
+
+int FoliageInstanceSet::instanceCount(){
+    return instanceCountSaved;
+}
+
+int FoliageInstanceSet::variantsUsedCount(){
+    return instancesByVariant.size();
+}
+
+/// @brief vertex count of the shared meshes used by this set, stored once
+int FoliageInstanceSet::instancedVertexCount(){
+    FoliageMeshRegistry *registry = FoliageMeshRegistry::instance();
+    int count = 0;
+    for (auto &pair : instancesByVariant){
+        count += registry->vertexCount(pair.first);
+    }
+    return count;
+}
+
+/// @brief vertex count the chunk would have if every instance was merged into its mesh
+int FoliageInstanceSet::mergedVertexCount(){
+    FoliageMeshRegistry *registry = FoliageMeshRegistry::instance();
+    int count = 0;
+    for (auto &pair : instancesByVariant){
+        count += registry->vertexCount(pair.first) * pair.second.Num();
+    }
+    return count;
+}
+
+/// @brief vertex count if every instance is drawn as impostor (far distance),
+/// bakes the impostors of the used variants if needed
+int FoliageInstanceSet::impostorVertexCount(){
+    FoliageMeshRegistry *registry = FoliageMeshRegistry::instance();
+    int count = 0;
+    for (auto &pair : instancesByVariant){
+        count += registry->impostorMeshByReference(pair.first).verteciesNum() * pair.second.Num();
+    }
+    return count;
+}
+
+/// @brief logs instance and vertex counts, used by the headless mode
+void FoliageInstanceSet::logReport(FString name){
+    FString message = FString::Printf(
+        TEXT("foliage %s: instances %d, variants %d, instanced vertecies %d, merged vertecies %d, impostor vertecies %d"),
+        *name,
+        instanceCount(),
+        variantsUsedCount(),
+        instancedVertexCount(),
+        mergedVertexCount(),
+        impostorVertexCount()
+    );
+    DebugHelper::logMessage(message);
+}
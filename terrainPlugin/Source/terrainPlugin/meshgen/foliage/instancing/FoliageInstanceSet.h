@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <map>
+
+/**
+ * instance transforms of one chunk grouped by the shared variant they reference.
+ * Pure data: can be filled and reported without a world (headless mode), the
+ * AfoliageInstanceActor turns it into instanced static mesh instances.
+ */
+class TERRAINPLUGIN_API FoliageInstanceSet
+{
+public:
+	FoliageInstanceSet();
+	~FoliageInstanceSet();
+
+	void clear();
+
+	void addInstance(int variantId, FTransform &transform);
+
+	std::map<int, TArray<FTransform>> &instancesByVariantRef();
+
+	int instanceCount();
+	int variantsUsedCount();
+	int instancedVertexCount();
+	int mergedVertexCount();
+	int impostorVertexCount();
+
+	void logReport(FString name);
+
+private:
+	std::map<int, TArray<FTransform>> instancesByVariant;
+	int instanceCountSaved = 0;
+};
@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FoliageMeshRegistry.h"
+#include "terrainPlugin/meshgen/foliage/impostor/ImpostorBaker.h"
+
+FoliageMeshRegistry *FoliageMeshRegistry::instancePointer = nullptr;
+
+void FoliageMeshRegistry::EndGame(){
+    if(FoliageMeshRegistry *ptr = instancePointer){
+        delete ptr;
+        FoliageMeshRegistry::instancePointer = nullptr;
+    }
+}
+
+/// @brief you are not allowed to delete this pointer!
+/// @return instance pointer
+FoliageMeshRegistry *FoliageMeshRegistry::instance(){
+    if(FoliageMeshRegistry::instancePointer == nullptr){
+        FoliageMeshRegistry::instancePointer = new FoliageMeshRegistry();
+    }
+    return FoliageMeshRegistry::instancePointer;
+}
+
+FoliageMeshRegistry::FoliageMeshRegistry()
+{
+}
+
+FoliageMeshRegistry::~FoliageMeshRegistry()
+{
+    stemMeshes.clear();
+    leafMeshes.clear();
+    stemHeights.clear();
+    impostorVariants.clear();
+    impostors.clear();
+    impostorMeshes.clear();
+}
+
+/// @brief copies the meshes into the registry
+/// @param stem stem mesh, target material must be set
+/// @param leaf leaf mesh, target material must be set
+/// @param hasImpostor true if the variant may be baked to an impostor (trees),
+/// solid props like rocks keep their mesh at every distance
+/// @return id of the new variant
+int FoliageMeshRegistry::registerVariant(MeshData &stem, MeshData &leaf, bool hasImpostor){
+    int id = nextId;
+    nextId++;
+
+    stemMeshes[id] = stem;
+    leafMeshes[id] = leaf;
+    impostorVariants[id] = hasImpostor;
+
+    float height = 0.0f;
+    TArray<FVector> &vertecies = stem.getVerteciesRef();
+    for (int i = 0; i < vertecies.Num(); i++){
+        height = std::max(height, (float)vertecies[i].Z);
+    }
+    stemHeights[id] = height;
+
+    return id;
+}
+
+bool FoliageMeshRegistry::isValidVariant(int id){
+    return stemMeshes.find(id) != stemMeshes.end();
+}
+
+bool FoliageMeshRegistry::hasImpostor(int id){
+    return impostorVariants.find(id) != impostorVariants.end() && impostorVariants[id];
+}
+
+MeshData &FoliageMeshRegistry::stemMeshByReference(int id){
+    if(isValidVariant(id)){
+        return stemMeshes[id];
+    }
+    return emptyMesh;
+}
+
+MeshData &FoliageMeshRegistry::leafMeshByReference(int id){
+    if(isValidVariant(id)){
+        return leafMeshes[id];
+    }
+    return emptyMesh;
+}
+
+/// @brief returns the impostor atlas of the variant, baked on the cpu on first use,
+/// empty for variants without impostor
+ImpostorAtlas &FoliageMeshRegistry::impostorByReference(int id){
+    if(hasImpostor(id)){
+        bakeImpostorIfNeeded(id);
+        return impostors[id];
+    }
+    return emptyAtlas;
+}
+
+/// @brief returns the crossed quad mesh matching the impostor atlas of the variant
+MeshData &FoliageMeshRegistry::impostorMeshByReference(int id){
+    if(hasImpostor(id)){
+        bakeImpostorIfNeeded(id);
+        return impostorMeshes[id];
+    }
+    return emptyMesh;
+}
+
+void FoliageMeshRegistry::bakeImpostorIfNeeded(int id){
+    if(impostors.find(id) != impostors.end()){
+        return;
+    }
+    ImpostorBaker baker;
+    ImpostorAtlas &atlas = impostors[id];
+    baker.bake(stemMeshes[id], leafMeshes[id], atlas);
+    impostorMeshes[id] = baker.createImpostorMesh(atlas);
+}
+
+/// @brief returns the vertex count of stem and leafs of one variant
+int FoliageMeshRegistry::vertexCount(int id){
+    if(isValidVariant(id)){
+        return stemMeshes[id].verteciesNum() + leafMeshes[id].verteciesNum();
+    }
+    return 0;
+}
+
+/// @brief returns the highest stem vertex, used for the collision proxy
+float FoliageMeshRegistry::stemHeight(int id){
+    if(stemHeights.find(id) != stemHeights.end()){
+        return stemHeights[id];
+    }
+    return 0.0f;
+}
+
+int FoliageMeshRegistry::variantCount(){
+    return stemMeshes.size();
+}
+
+/// @brief returns the vertex count of all shared meshes together
+int FoliageMeshRegistry::sharedVertexCount(){
+    int count = 0;
+    for (auto &pair : stemMeshes){
+        count += vertexCount(pair.first);
+    }
+    return count;
+}
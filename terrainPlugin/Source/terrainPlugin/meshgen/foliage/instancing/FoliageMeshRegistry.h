@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameCore/MeshGenBase/MeshData/MeshData.h"
+#include "terrainPlugin/meshgen/foliage/impostor/ImpostorAtlas.h"
+#include <map>
+
+/**
+ * owns the shared foliage meshes (stem and leaf mesh data per variant),
+ * instances only reference a variant by id. Pure data, works without a world.
+ */
+class TERRAINPLUGIN_API FoliageMeshRegistry
+{
+public:
+	static FoliageMeshRegistry *instance();
+	static void EndGame();
+	~FoliageMeshRegistry();
+
+	int registerVariant(MeshData &stem, MeshData &leaf, bool hasImpostor);
+
+	bool isValidVariant(int id);
+	bool hasImpostor(int id);
+	MeshData &stemMeshByReference(int id);
+	MeshData &leafMeshByReference(int id);
+
+	ImpostorAtlas &impostorByReference(int id);
+	MeshData &impostorMeshByReference(int id);
+
+	int vertexCount(int id);
+	float stemHeight(int id);
+
+	int variantCount();
+	int sharedVertexCount();
+
+private:
+	FoliageMeshRegistry();
+	static class FoliageMeshRegistry *instancePointer;
+
+	/// @brief map keeps references stable when new variants are added
+	std::map<int, MeshData> stemMeshes;
+	std::map<int, MeshData> leafMeshes;
+	std::map<int, float> stemHeights;
+
+	/// @brief variants which get a far representation, trees only
+	std::map<int, bool> impostorVariants;
+
+	/// @brief far representation, baked on first use
+	std::map<int, ImpostorAtlas> impostors;
+	std::map<int, MeshData> impostorMeshes;
+
+	void bakeImpostorIfNeeded(int id);
+
+	int nextId = 0;
+
+	MeshData emptyMesh;
+	ImpostorAtlas emptyAtlas;
+};
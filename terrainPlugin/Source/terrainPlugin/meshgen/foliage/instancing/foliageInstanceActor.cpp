@@ -0,0 +1,317 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "foliageInstanceActor.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "MeshDescription.h"
+#include "MeshDescriptionBuilder.h"
+#include "StaticMeshAttributes.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "AssetPlugin/gamestart/assetManager.h"
+#include "terrainPlugin/meshgen/foliage/instancing/FoliageMeshRegistry.h"
+#include "terrainPlugin/meshgen/foliage/impostor/ImpostorAtlas.h"
+
+TWeakObjectPtr<AfoliageInstanceActor> AfoliageInstanceActor::instancePointer = nullptr;
+
+AfoliageInstanceActor::AfoliageInstanceActor()
+{
+	//instances dont need any tick
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("foliageRoot"));
+}
+
+void AfoliageInstanceActor::BeginPlay(){
+	Super::BeginPlay();
+}
+
+/// @brief returns the foliage actor for the world, spawns it at the origin if needed
+/// @param world world to find for
+/// @return actor or nullptr if world is nullptr
+AfoliageInstanceActor *AfoliageInstanceActor::instance(UWorld *world){
+	if(world == nullptr){
+		return nullptr;
+	}
+	if(instancePointer.IsValid() && instancePointer->GetWorld() == world){
+		return instancePointer.Get();
+	}
+
+	FActorSpawnParameters params;
+	AfoliageInstanceActor *spawned = world->SpawnActor<AfoliageInstanceActor>(
+		AfoliageInstanceActor::StaticClass(),
+		FVector::ZeroVector,
+		FRotator::ZeroRotator,
+		params
+	);
+	instancePointer = spawned;
+	return spawned;
+}
+
+/// @brief adds all instances of the set, transforms are expected in world space
+/// (the actor stays at the origin)
+void AfoliageInstanceActor::addInstances(FoliageInstanceSet &set){
+	std::map<int, TArray<FTransform>> &instances = set.instancesByVariantRef();
+	for (auto &pair : instances){
+		UHierarchicalInstancedStaticMeshComponent *component = componentForVariant(pair.first);
+		if(component != nullptr && pair.second.Num() > 0){
+			component->AddInstances(pair.second, false);
+
+			//same transforms, the impostor takes over where the full mesh is culled
+			if(impostorIndexByVariant.find(pair.first) != impostorIndexByVariant.end()){
+				impostorComponents[impostorIndexByVariant[pair.first]]->AddInstances(pair.second, false);
+			}
+		}
+	}
+}
+
+/// @brief instances of the full meshes, the impostor copies are not counted
+int AfoliageInstanceActor::instanceCount(){
+	int count = 0;
+	for (int i = 0; i < variantComponents.Num(); i++){
+		if(variantComponents[i] != nullptr){
+			count += variantComponents[i]->GetInstanceCount();
+		}
+	}
+	return count;
+}
+
+/// @brief finds or creates the instanced component for a registered variant,
+/// trees with an impostor get a second component for the impostor quads
+UHierarchicalInstancedStaticMeshComponent *AfoliageInstanceActor::componentForVariant(int variantId){
+	if(componentIndexByVariant.find(variantId) != componentIndexByVariant.end()){
+		return variantComponents[componentIndexByVariant[variantId]];
+	}
+
+	FoliageMeshRegistry *registry = FoliageMeshRegistry::instance();
+	if(!registry->isValidVariant(variantId)){
+		return nullptr;
+	}
+
+	UStaticMesh *staticMesh = createStaticMesh(variantId);
+	if(staticMesh == nullptr){
+		return nullptr;
+	}
+
+	UStaticMesh *impostorMesh = createImpostorStaticMesh(variantId);
+	int fullMeshCullDistance = impostorMesh != nullptr ? IMPOSTOR_DISTANCE : CULL_DISTANCE;
+
+	UHierarchicalInstancedStaticMeshComponent *component = createComponent(
+		staticMesh,
+		0,
+		fullMeshCullDistance
+	);
+	componentIndexByVariant[variantId] = variantComponents.Num();
+	variantComponents.Add(component);
+
+	if(impostorMesh != nullptr){
+		UHierarchicalInstancedStaticMeshComponent *impostorComponent = createComponent(
+			impostorMesh,
+			IMPOSTOR_DISTANCE,
+			CULL_DISTANCE
+		);
+		//start cull distance only fades, the near impostors are hidden by the draw distance
+		impostorComponent->MinDrawDistance = IMPOSTOR_DISTANCE;
+		impostorIndexByVariant[variantId] = impostorComponents.Num();
+		impostorComponents.Add(impostorComponent);
+	}
+	return component;
+}
+
+/// @brief creates and registers an instanced component without collision
+/// @param startCull instances closer than this are faded out (cm)
+/// @param endCull instances further away than this are culled (cm)
+UHierarchicalInstancedStaticMeshComponent *AfoliageInstanceActor::createComponent(
+	UStaticMesh *staticMesh,
+	int startCull,
+	int endCull
+){
+	UHierarchicalInstancedStaticMeshComponent *component =
+		NewObject<UHierarchicalInstancedStaticMeshComponent>(this);
+	component->SetStaticMesh(staticMesh);
+	component->SetCollisionEnabled(ECollisionEnabled::NoCollision); //collision from chunk proxies
+	component->SetCullDistances(startCull, endCull);
+	component->SetupAttachment(RootComponent);
+	component->RegisterComponent();
+	return component;
+}
+
+/**
+ * 
+ * --- mesh data to static mesh ---
+ * 
+ */
+
+/// @brief creates a static mesh with two sections, stem and leaf, materials by
+/// the target material of the mesh data
+UStaticMesh *AfoliageInstanceActor::createStaticMesh(int variantId){
+	FoliageMeshRegistry *registry = FoliageMeshRegistry::instance();
+	MeshData &stem = registry->stemMeshByReference(variantId);
+	MeshData &leaf = registry->leafMeshByReference(variantId);
+	if(stem.verteciesNum() == 0 && leaf.verteciesNum() == 0){
+		return nullptr;
+	}
+
+	FMeshDescription meshDescription;
+	FStaticMeshAttributes attributes(meshDescription);
+	attributes.Register();
+
+	FMeshDescriptionBuilder builder;
+	builder.SetMeshDescription(&meshDescription);
+	builder.EnablePolyGroups();
+	builder.SetNumUVLayers(1);
+
+	appendToMeshDescription(builder, stem, 0);
+	appendToMeshDescription(builder, leaf, 1);
+
+	UStaticMesh *staticMesh = NewObject<UStaticMesh>(this);
+
+	assetManager *assets = assetManager::instance();
+	std::vector<MeshData *> sections = {&stem, &leaf};
+	for (int i = 0; i < sections.size(); i++){
+		UMaterialInterface *material = nullptr;
+		if(assets != nullptr){
+			material = assets->findMaterial(sections[i]->targetMaterial());
+		}
+		FName slotName(*FString::Printf(TEXT("section%d"), i));
+		staticMesh->GetStaticMaterials().Add(FStaticMaterial(material, slotName));
+	}
+
+	buildFromMeshDescription(staticMesh, meshDescription);
+	return staticMesh;
+}
+
+/// @brief creates the static mesh of the impostor quads, only for trees whose impostor
+/// could be baked and only with a material which can display the atlas
+/// @return mesh or nullptr if the variant is drawn without impostor
+UStaticMesh *AfoliageInstanceActor::createImpostorStaticMesh(int variantId){
+	FoliageMeshRegistry *registry = FoliageMeshRegistry::instance();
+	if(!registry->hasImpostor(variantId)){
+		return nullptr;
+	}
+	ImpostorAtlas &atlas = registry->impostorByReference(variantId);
+	MeshData &impostorMesh = registry->impostorMeshByReference(variantId);
+	if(!atlas.isValid() || impostorMesh.verteciesNum() == 0){
+		return nullptr;
+	}
+	UMaterialInterface *impostorMaterial = createImpostorMaterial(atlas);
+	if(impostorMaterial == nullptr){
+		return nullptr;
+	}
+
+	FMeshDescription meshDescription;
+	FStaticMeshAttributes attributes(meshDescription);
+	attributes.Register();
+
+	FMeshDescriptionBuilder builder;
+	builder.SetMeshDescription(&meshDescription);
+	builder.EnablePolyGroups();
+	builder.SetNumUVLayers(1);
+	appendToMeshDescription(builder, impostorMesh, 0);
+
+	UStaticMesh *staticMesh = NewObject<UStaticMesh>(this);
+	staticMesh->GetStaticMaterials().Add(FStaticMaterial(impostorMaterial, FName(TEXT("section0"))));
+
+	buildFromMeshDescription(staticMesh, meshDescription);
+	return staticMesh;
+}
+
+/// @brief builds the render data directly from the description, works in cooked builds
+void AfoliageInstanceActor::buildFromMeshDescription(
+	UStaticMesh *staticMesh,
+	FMeshDescription &meshDescription
+){
+	UStaticMesh::FBuildMeshDescriptionsParams params;
+	params.bBuildSimpleCollision = false;
+	params.bFastBuild = true;
+
+	TArray<const FMeshDescription *> descriptions;
+	descriptions.Add(&meshDescription);
+	staticMesh->BuildFromMeshDescriptions(descriptions, params);
+}
+
+/// @brief uploads the cpu atlas into a transient texture
+UTexture2D *AfoliageInstanceActor::createImpostorTexture(ImpostorAtlas &atlas){
+	UTexture2D *texture = UTexture2D::CreateTransient(atlas.width(), atlas.height(), PF_B8G8R8A8);
+	if(texture == nullptr){
+		return nullptr;
+	}
+
+	TArray<FColor> &pixels = atlas.pixelsByReference();
+	FTexture2DMipMap &mip = texture->GetPlatformData()->Mips[0];
+	void *data = mip.BulkData.Lock(LOCK_READ_WRITE);
+	FMemory::Memcpy(data, pixels.GetData(), pixels.Num() * sizeof(FColor));
+	mip.BulkData.Unlock();
+
+	texture->UpdateResource();
+	return texture;
+}
+
+/// @brief dynamic instance of the impostor material with the atlas set as
+/// texture parameter "ImpostorAtlas"
+/// @return material or nullptr if the impostor material is missing, not masked
+/// or does not read the atlas parameter
+UMaterialInterface *AfoliageInstanceActor::createImpostorMaterial(ImpostorAtlas &atlas){
+	assetManager *assets = assetManager::instance();
+	if(assets == nullptr){
+		return nullptr;
+	}
+	UMaterialInterface *parent = assets->findMaterial(materialEnum::impostorMaterial);
+	if(parent == nullptr || parent->GetBlendMode() != BLEND_Masked){
+		return nullptr;
+	}
+	UTexture *defaultAtlas = nullptr;
+	FName parameterName(TEXT("ImpostorAtlas"));
+	if(!parent->GetTextureParameterValue(FHashedMaterialParameterInfo(parameterName), defaultAtlas)){
+		return nullptr;
+	}
+
+	UTexture2D *texture = createImpostorTexture(atlas);
+	if(texture == nullptr){
+		return nullptr;
+	}
+	UMaterialInstanceDynamic *material = UMaterialInstanceDynamic::Create(parent, this);
+	material->SetTextureParameterValue(parameterName, texture);
+	return material;
+}
+
+/// @brief appends the mesh data as its own polygon group, triangle order is kept
+/// as in the procedural mesh
+void AfoliageInstanceActor::appendToMeshDescription(
+	FMeshDescriptionBuilder &builder,
+	MeshData &meshData,
+	int polygonGroupIndex
+){
+	FPolygonGroupID group = builder.AppendPolygonGroup(
+		FName(*FString::Printf(TEXT("section%d"), polygonGroupIndex))
+	);
+
+	TArray<FVector> &vertecies = meshData.getVerteciesRef();
+	TArray<FVector> &normals = meshData.getNormalsRef();
+	TArray<FVector2D> &uvs = meshData.getUV0Ref();
+	TArray<int32> &triangles = meshData.getTrianglesRef();
+	bool hasNormals = normals.Num() == vertecies.Num();
+	bool hasUvs = uvs.Num() == vertecies.Num();
+
+	TArray<FVertexInstanceID> instances;
+	instances.Reserve(vertecies.Num());
+	for (int i = 0; i < vertecies.Num(); i++){
+		FVertexID vertexId = builder.AppendVertex(vertecies[i]);
+		FVertexInstanceID instanceId = builder.AppendInstance(vertexId);
+		if(hasNormals){
+			builder.SetInstanceNormal(instanceId, normals[i]);
+		}
+		builder.SetInstanceUV(instanceId, hasUvs ? uvs[i] : FVector2D(0, 0), 0);
+		instances.Add(instanceId);
+	}
+
+	for (int i = 2; i < triangles.Num(); i += 3){
+		int32 v0 = triangles[i - 2];
+		int32 v1 = triangles[i - 1];
+		int32 v2 = triangles[i];
+		if(instances.IsValidIndex(v0) && instances.IsValidIndex(v1) && instances.IsValidIndex(v2)){
+			builder.AppendTriangle(instances[v0], instances[v1], instances[v2], group);
+		}
+	}
+}
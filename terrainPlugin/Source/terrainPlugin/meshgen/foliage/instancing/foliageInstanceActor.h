@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "GameCore/MeshGenBase/MeshData/MeshData.h"
+#include "terrainPlugin/meshgen/foliage/instancing/FoliageInstanceSet.h"
+#include <map>
+#include "foliageInstanceActor.generated.h"
+
+class UStaticMesh;
+class UTexture2D;
+class UMaterialInterface;
+class UHierarchicalInstancedStaticMeshComponent;
+class FMeshDescriptionBuilder;
+struct FMeshDescription;
+class ImpostorAtlas;
+
+/**
+ * renders all foliage of a world through one hierarchical instanced static mesh
+ * component per shared variant. The static meshes are built once from the
+ * MeshData in the FoliageMeshRegistry. Trees with a baked impostor and the masked impostor
+ * material get a second component with the impostor quads, the full mesh is culled at
+ * IMPOSTOR_DISTANCE and the impostor is drawn from there to CULL_DISTANCE.
+ */
+UCLASS()
+class TERRAINPLUGIN_API AfoliageInstanceActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AfoliageInstanceActor();
+
+	static AfoliageInstanceActor *instance(UWorld *world);
+
+	void addInstances(FoliageInstanceSet &set);
+
+	int instanceCount();
+
+	/// @brief instances are culled beyond this distance (cm), same as the far lod
+	static const int CULL_DISTANCE = 300 * 100;
+
+	/// @brief trees are swapped to the impostor beyond this distance (cm)
+	static const int IMPOSTOR_DISTANCE = 60 * 100;
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	static TWeakObjectPtr<AfoliageInstanceActor> instancePointer;
+
+	UPROPERTY()
+	TArray<UHierarchicalInstancedStaticMeshComponent *> variantComponents;
+
+	UPROPERTY()
+	TArray<UHierarchicalInstancedStaticMeshComponent *> impostorComponents;
+
+	/// @brief variant id to index in variantComponents
+	std::map<int, int> componentIndexByVariant;
+
+	/// @brief variant id to index in impostorComponents, only trees with an impostor
+	std::map<int, int> impostorIndexByVariant;
+
+	UHierarchicalInstancedStaticMeshComponent *componentForVariant(int variantId);
+	UHierarchicalInstancedStaticMeshComponent *createComponent(
+		UStaticMesh *staticMesh,
+		int startCull,
+		int endCull
+	);
+
+	UStaticMesh *createStaticMesh(int variantId);
+	UStaticMesh *createImpostorStaticMesh(int variantId);
+	void buildFromMeshDescription(UStaticMesh *staticMesh, FMeshDescription &meshDescription);
+	UTexture2D *createImpostorTexture(ImpostorAtlas &atlas);
+	UMaterialInterface *createImpostorMaterial(ImpostorAtlas &atlas);
+	void appendToMeshDescription(
+		FMeshDescriptionBuilder &builder,
+		MeshData &meshData,
+		int polygonGroupIndex
+	);
+};
@@ -0,0 +1,232 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PoissonDiskSampler.h"
+
+PoissonDiskSampler::PoissonDiskSampler(float minDistanceIn, int32 seed)
+{
+    minDistance = std::max(1.0f, minDistanceIn);
+    random.Initialize(seed);
+}
+
+PoissonDiskSampler::~PoissonDiskSampler()
+{
+    mapPtr = nullptr;
+    freeGridPtr = nullptr;
+}
+
+/// @brief limits the slope of accepted positions, by the up component of the ground normal
+/// @param minUpIn 1 only flat ground, 0 any slope
+/// @param maxUpIn 1 allows flat ground, lower values only allow slopes
+void PoissonDiskSampler::setNormalUpRange(float minUpIn, float maxUpIn){
+    minUp = FMath::Clamp(std::min(minUpIn, maxUpIn), 0.0f, 1.0f);
+    maxUp = FMath::Clamp(std::max(minUpIn, maxUpIn), 0.0f, 1.0f);
+}
+
+/// @brief count of rejected candidates of the last sample call
+int PoissonDiskSampler::rejectedCount(){
+    return rejected;
+}
+
+/// @brief samples positions with at least minDistance between them
+/// @param map local node map of the chunk, regular spacing on x and y
+/// @param freeGrid occupancy per node, true is free, same size as the map
+/// @param maxCount max positions to create
+/// @param output local positions on the terrain surface, appended
+void PoissonDiskSampler::sample(
+    std::vector<std::vector<FVector>> &map,
+    std::vector<std::vector<bool>> &freeGrid,
+    int maxCount,
+    std::vector<FVector> &output
+){
+    samples.clear();
+    active.clear();
+    rejected = 0;
+    if(maxCount <= 0 || !setupMap(map, freeGrid)){
+        return;
+    }
+    setupBackgroundGrid();
+
+    //seed candidates: all free nodes in shuffled order, one is used whenever
+    //the active list runs empty, so separated free areas are filled too
+    std::vector<FVector2D> seeds;
+    for (int i = 0; i < nodesX; i++){
+        for (int j = 0; j < nodesY; j++){
+            if(freeGrid[i][j]){
+                seeds.push_back(FVector2D(map[i][j].X, map[i][j].Y));
+            }
+        }
+    }
+    for (int i = seeds.size() - 1; i > 0; i--){
+        int swapIndex = random.RandRange(0, i);
+        std::swap(seeds[i], seeds[swapIndex]);
+    }
+
+    int nextSeed = 0;
+    while (samples.size() < maxCount){
+        if(active.size() == 0){
+            bool added = false;
+            while (!added && nextSeed < seeds.size()){
+                added = tryAdd(seeds[nextSeed]);
+                nextSeed++;
+            }
+            if(!added){
+                break; //no free area left
+            }
+            continue;
+        }
+
+        int activeSlot = random.RandRange(0, active.size() - 1);
+        FVector &center = samples[active[activeSlot]];
+
+        bool found = false;
+        for (int k = 0; k < ATTEMPTS_PER_SAMPLE && !found; k++){
+            //annulus r..2r
+            float angle = random.FRandRange(0.0f, 2.0f * PI);
+            float distance = minDistance * (1.0f + random.FRand());
+            FVector2D candidate(
+                center.X + std::cos(angle) * distance,
+                center.Y + std::sin(angle) * distance
+            );
+            found = tryAdd(candidate);
+        }
+
+        if(!found){
+            //retire, order of active list does not matter
+            active[activeSlot] = active.back();
+            active.pop_back();
+        }
+    }
+
+    for (int i = 0; i < samples.size(); i++){
+        output.push_back(samples[i]);
+    }
+}
+
+bool PoissonDiskSampler::setupMap(
+    std::vector<std::vector<FVector>> &map,
+    std::vector<std::vector<bool>> &freeGrid
+){
+    if(map.size() < 2 || map[0].size() < 2){
+        return false;
+    }
+    if(freeGrid.size() < map.size() || freeGrid[0].size() < map[0].size()){
+        return false;
+    }
+    mapPtr = &map;
+    freeGridPtr = &freeGrid;
+    nodesX = map.size();
+    nodesY = map[0].size();
+    origin = FVector2D(map[0][0].X, map[0][0].Y);
+    nodeDistance = std::max(1.0f, (float) (map[1][0].X - map[0][0].X));
+    return true;
+}
+
+void PoissonDiskSampler::setupBackgroundGrid(){
+    cellSize = minDistance / std::sqrt(2.0f);
+    float extentX = (nodesX - 1) * nodeDistance;
+    float extentY = (nodesY - 1) * nodeDistance;
+    cellsX = std::max(1, (int) std::ceil(extentX / cellSize) + 1);
+    cellsY = std::max(1, (int) std::ceil(extentY / cellSize) + 1);
+    cells.assign(cellsX * cellsY, -1);
+}
+
+/// @brief adds the candidate if it is placable and far enough from all samples
+bool PoissonDiskSampler::tryAdd(FVector2D &candidate){
+    if(!isPlacable(candidate) || !isFarEnough(candidate)){
+        rejected++;
+        return false;
+    }
+    int index = samples.size();
+    samples.push_back(FVector(candidate.X, candidate.Y, heightAt(candidate)));
+    active.push_back(index);
+    cells[cellIndexFor(candidate)] = index;
+    return true;
+}
+
+/// @brief inside the map, on a free node and the ground slope is in range
+bool PoissonDiskSampler::isPlacable(FVector2D &candidate){
+    int i = 0;
+    int j = 0;
+    if(!nodeIndexFor(candidate, i, j)){
+        return false;
+    }
+
+    //closest node decides, same as the old per node positions
+    int closestI = std::min(nodesX - 1, (int) std::round((candidate.X - origin.X) / nodeDistance));
+    int closestJ = std::min(nodesY - 1, (int) std::round((candidate.Y - origin.Y) / nodeDistance));
+    if(!(*freeGridPtr)[closestI][closestJ]){
+        return false;
+    }
+
+    FVector normal = normalAt(i, j).GetSafeNormal();
+    float up = std::abs(normal.Z);
+    return up >= minUp && up <= maxUp;
+}
+
+/// @brief checks the 5x5 neighbour cells, each cell holds at most one sample
+bool PoissonDiskSampler::isFarEnough(FVector2D &candidate){
+    int cx = (candidate.X - origin.X) / cellSize;
+    int cy = (candidate.Y - origin.Y) / cellSize;
+    float minDistanceSquared = minDistance * minDistance;
+
+    for (int x = std::max(0, cx - 2); x <= std::min(cellsX - 1, cx + 2); x++){
+        for (int y = std::max(0, cy - 2); y <= std::min(cellsY - 1, cy + 2); y++){
+            int other = cells[x * cellsY + y];
+            if(other >= 0){
+                FVector &otherSample = samples[other];
+                float dx = otherSample.X - candidate.X;
+                float dy = otherSample.Y - candidate.Y;
+                if(dx * dx + dy * dy < minDistanceSquared){
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+int PoissonDiskSampler::cellIndexFor(FVector2D &position){
+    int cx = std::min(cellsX - 1, std::max(0, (int) ((position.X - origin.X) / cellSize)));
+    int cy = std::min(cellsY - 1, std::max(0, (int) ((position.Y - origin.Y) / cellSize)));
+    return cx * cellsY + cy;
+}
+
+/// @brief lower left node of the quad containing the position
+/// @return false if outside the map
+bool PoissonDiskSampler::nodeIndexFor(FVector2D &position, int &i, int &j){
+    float localX = (position.X - origin.X) / nodeDistance;
+    float localY = (position.Y - origin.Y) / nodeDistance;
+    if(localX < 0.0f || localY < 0.0f){
+        return false;
+    }
+    i = (int) localX;
+    j = (int) localY;
+    if(i >= nodesX - 1 || j >= nodesY - 1){
+        return false;
+    }
+    return true;
+}
+
+/// @brief bilinear height inside the quad of the position
+float PoissonDiskSampler::heightAt(FVector2D &position){
+    int i = 0;
+    int j = 0;
+    if(!nodeIndexFor(position, i, j)){
+        return 0.0f;
+    }
+    std::vector<std::vector<FVector>> &map = *mapPtr;
+    float tx = (position.X - origin.X) / nodeDistance - i;
+    float ty = (position.Y - origin.Y) / nodeDistance - j;
+
+    float bottom = FMath::Lerp(map[i][j].Z, map[i + 1][j].Z, tx);
+    float top = FMath::Lerp(map[i][j + 1].Z, map[i + 1][j + 1].Z, tx);
+    return FMath::Lerp(bottom, top, ty);
+}
+
+FVector PoissonDiskSampler::normalAt(int i, int j){
+    std::vector<std::vector<FVector>> &map = *mapPtr;
+    FVector alongX = map[i + 1][j] - map[i][j];
+    FVector alongY = map[i][j + 1] - map[i][j];
+    return FVector::CrossProduct(alongX, alongY);
+}
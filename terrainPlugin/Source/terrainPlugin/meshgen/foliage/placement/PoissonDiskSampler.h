@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include <vector>
+
+/**
+ * blue noise foliage placement (Bridson poisson disk sampling) over the node map of a chunk.
+ * Candidates are only accepted on nodes which are free in the occupancy grid
+ * (see terrainCreator::chunk::blockAreaForFoliage) and on ground inside the slope range.
+ * Rejection uses a background grid with one sample per cell (cell size radius / sqrt 2),
+ * the result only depends on the map, the occupancy and the seed.
+ */
+class TERRAINPLUGIN_API PoissonDiskSampler
+{
+public:
+	PoissonDiskSampler(float minDistanceIn, int32 seed);
+	~PoissonDiskSampler();
+
+	/// @brief candidates tried around each active sample (Bridson k)
+	static const int ATTEMPTS_PER_SAMPLE = 30;
+
+	void sample(
+		std::vector<std::vector<FVector>> &map,
+		std::vector<std::vector<bool>> &freeGrid,
+		int maxCount,
+		std::vector<FVector> &output
+	);
+
+	void setNormalUpRange(float minUpIn, float maxUpIn);
+
+	int rejectedCount();
+
+private:
+	float minDistance = 100.0f;
+	FRandomStream random;
+
+	/// @brief allowed abs z of the normalized ground normal, default is FVectorUtil::directionIsVertical
+	float minUp = 0.7f;
+	float maxUp = 1.0f;
+
+	//map
+	std::vector<std::vector<FVector>> *mapPtr = nullptr;
+	std::vector<std::vector<bool>> *freeGridPtr = nullptr;
+	FVector2D origin;
+	float nodeDistance = 1.0f;
+	int nodesX = 0;
+	int nodesY = 0;
+
+	//background grid
+	float cellSize = 1.0f;
+	int cellsX = 0;
+	int cellsY = 0;
+	std::vector<int> cells;
+
+	std::vector<FVector> samples;
+	std::vector<int> active;
+	int rejected = 0;
+
+	bool setupMap(
+		std::vector<std::vector<FVector>> &map,
+		std::vector<std::vector<bool>> &freeGrid
+	);
+	void setupBackgroundGrid();
+
+	bool tryAdd(FVector2D &candidate);
+	bool isPlacable(FVector2D &candidate);
+	bool isFarEnough(FVector2D &candidate);
+
+	int cellIndexFor(FVector2D &position);
+	bool nodeIndexFor(FVector2D &position, int &i, int &j);
+	float heightAt(FVector2D &position);
+	FVector normalAt(int i, int j);
+};
@@ -7,6 +7,7 @@
 RockCreator::RockCreator()
 {
     rockMaxSize = 2000;
+    random.GenerateNewSeed();
 }
 
 RockCreator::RockCreator(int maxSize)
@@ -15,12 +16,18 @@ RockCreator::RockCreator(int maxSize)
     if(maxSize > 100){
         rockMaxSize = maxSize;
     }
+    random.GenerateNewSeed();
 }
 
 RockCreator::~RockCreator()
 {
 }
 
+/// @brief same seed and same parameters create the same rock
+void RockCreator::setSeed(int32 seed){
+    random.Initialize(seed);
+}
+
 
 
 
@@ -128,8 +135,8 @@ FVectorShape RockCreator::createShape(int detailStep, int sizeX, int sizeY){
             countNow
         );
     }
-    outShape.randomizeVertecies(detailStep / 2); //must be made more random
-    outShape.smoothWithBezier(detailStep / 10); //must be made by some other function
+    outShape.randomizeVertecies(detailStep / 2, random); //must be made more random
+    outShape.smoothWithBezier(detailStep / 10, arena); //must be made by some other function
 
     //debug log vertex count
     FString message = FString::Printf(TEXT("debugShape vertex count %d"), outShape.vertexCount());
@@ -181,8 +188,8 @@ void RockCreator::addVertecies(
         //baseShape.moveVerteciesWith(downScale);
 
         FVectorShape copy = baseShape;
-        copy.randomizeVertecies(detailStep);
-        copy.smoothWithBezier(detailStep / 10); //must be made by some other function
+        copy.randomizeVertecies(detailStep, random);
+        copy.smoothWithBezier(detailStep / 10, arena); //must be made by some other function
 
         shapes.push_back(copy);
     }
@@ -194,11 +201,14 @@ void RockCreator::addVertecies(
 FVectorShape RockCreator::createRandomShape(int detailStep){
     //create random vertecies
     detailStep = std::abs(detailStep);
-    int vertexCount = FVectorUtil::randomNumber(30, 50);
+    int vertexCount = random.RandRange(30, 50);
     std::vector<FVector> vertecies;
     for (int i = 0; i < vertexCount; i++){
-        FVector newVertex = FVectorUtil::randomOffset(rockMaxSize);
-        newVertex.Z = 0.0f; //remove z height
+        FVector newVertex(
+            random.RandRange(-rockMaxSize, rockMaxSize),
+            random.RandRange(-rockMaxSize, rockMaxSize),
+            0.0f //remove z height
+        );
         vertecies.push_back(newVertex);
     }
 
@@ -221,7 +231,7 @@ FVectorShape RockCreator::createRandomShape(int detailStep){
         }
     }
 
-    shape.smoothWithBezier(detailStep / 10); // must be made by some other function
+    shape.smoothWithBezier(detailStep / 10, arena); // must be made by some other function
     shape.makeCenterPivot();
 
     return shape;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Math/RandomStream.h"
 #include "terrainPlugin/meshgen/foliage/helper/FVectorShape.h"
 #include "GameCore/MeshGenBase/MeshData/MeshData.h"
 /**
@@ -19,8 +20,15 @@ public:
 	MeshData createMesh();
 	MeshData createMesh(int sizeX, int sizeY, int detailStep, int layers, int heightStep);
 
+	void setSeed(int32 seed);
+
 private:
-	
+	/// @brief seeded with setSeed for reproducable rocks, random otherwise
+	FRandomStream random;
+
+	/// @brief scratch buffers for shape smoothing, reused for every layer
+	ShapeArena arena;
+
 	int rockMaxSize = 2000;
 
 	FVectorShape createShape(int detailStep, int sizeX, int sizeY);
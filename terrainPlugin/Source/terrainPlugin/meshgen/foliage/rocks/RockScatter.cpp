@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RockScatter.h"
+#include "Math/RandomStream.h"
+#include "terrainPlugin/meshgen/generation/helper/TerrainChunkSetup.h"
+#include "terrainPlugin/meshgen/foliage/placement/PoissonDiskSampler.h"
+#include "terrainPlugin/meshgen/foliage/rocks/RockVariantLibrary.h"
+
+RockScatter::RockScatter()
+{
+}
+
+RockScatter::~RockScatter()
+{
+}
+
+/// @brief rocks per map node for the terrain type
+float RockScatter::densityFor(ETerrainType type){
+    if(type == ETerrainType::EDesert) return 0.02f;
+    if(type == ETerrainType::ESnowHill) return 0.02f;
+    if(type == ETerrainType::EDesertForest) return 0.015f;
+    if(type == ETerrainType::EForest) return 0.01f;
+    if(type == ETerrainType::ETropical) return 0.005f;
+    return 0.0f; //ocean
+}
+
+/// @brief creates the rock placements of a chunk
+/// @param package chunk setup with map, occupancy and seed
+/// @param blockedLocations local positions already taken (for example trees)
+/// @param variantsOut variant id per placement, appended
+/// @param transformsOut local transform per placement, appended
+void RockScatter::scatter(
+    TerrainChunkSetup &package,
+    std::vector<FVector> &blockedLocations,
+    std::vector<int> &variantsOut,
+    std::vector<FTransform> &transformsOut
+){
+    std::vector<std::vector<FVector>> &map = package.mapReference();
+    float density = densityFor(package.getTerrainType());
+    if(density <= 0.0f || map.size() < 2 || map[0].size() < 2){
+        return;
+    }
+
+    //copy, the chunk occupancy stays untouched
+    std::vector<std::vector<bool>> freeGrid = package.freeFoliageGridRef();
+    if(freeGrid.size() < map.size()){
+        return;
+    }
+    blockNodesAround(map, freeGrid, blockedLocations);
+
+    int nodes = map.size() * map[0].size();
+    int maxCount = std::max(1, (int) (density * nodes));
+
+    float nodeDistance = map[1][0].X - map[0][0].X;
+    float minDistance = std::sqrt((nodeDistance * nodeDistance) / density * 0.5f);
+
+    //own stream, independent of the tree placement
+    int32 seed = package.foliagePlacementSeed() ^ 0x5bd1e995;
+    PoissonDiskSampler sampler(minDistance, seed);
+    sampler.setNormalUpRange(0.35f, 0.97f); //slopes, no cliffs, rarely flat ground
+
+    std::vector<FVector> positions;
+    sampler.sample(map, freeGrid, maxCount, positions);
+
+    RockVariantLibrary *library = RockVariantLibrary::instance();
+    FRandomStream random(seed);
+    for (int i = 0; i < positions.size(); i++){
+        int variantId = library->randomVariant(random);
+        if(variantId < 0){
+            return;
+        }
+        float scale = random.FRandRange(0.2f, 0.6f);
+        FRotator rotation(0, random.FRandRange(0.0f, 360.0f), 0);
+        FTransform transform(rotation, positions[i], FVector(scale));
+
+        variantsOut.push_back(variantId);
+        transformsOut.push_back(transform);
+    }
+}
+
+/// @brief marks the nodes around each blocked location as taken
+void RockScatter::blockNodesAround(
+    std::vector<std::vector<FVector>> &map,
+    std::vector<std::vector<bool>> &freeGrid,
+    std::vector<FVector> &blockedLocations
+){
+    FVector &origin = map[0][0];
+    float nodeDistance = std::max(1.0f, (float) (map[1][0].X - map[0][0].X));
+    int sizeX = freeGrid.size();
+
+    for (int i = 0; i < blockedLocations.size(); i++){
+        FVector &current = blockedLocations[i];
+        int x = std::round((current.X - origin.X) / nodeDistance);
+        int y = std::round((current.Y - origin.Y) / nodeDistance);
+        for (int bx = x - 1; bx <= x + 1; bx++){
+            for (int by = y - 1; by <= y + 1; by++){
+                if(bx >= 0 && bx < sizeX && by >= 0 && by < freeGrid[bx].size()){
+                    freeGrid[bx][by] = false;
+                }
+            }
+        }
+    }
+}
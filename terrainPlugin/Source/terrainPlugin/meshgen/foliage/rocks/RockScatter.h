@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameCore/MeshGenBase/foliage/ETerrainType.h"
+#include <vector>
+
+class TerrainChunkSetup;
+
+/**
+ * places rock instances of the RockVariantLibrary on a chunk: poisson disk sampled on the
+ * free nodes of the chunk occupancy, preferring slopes, density by terrain type.
+ * Emits variant ids and local transforms only, no geometry is merged.
+ * Same chunk, same rocks.
+ */
+class TERRAINPLUGIN_API RockScatter
+{
+public:
+	RockScatter();
+	~RockScatter();
+
+	void scatter(
+		TerrainChunkSetup &package,
+		std::vector<FVector> &blockedLocations,
+		std::vector<int> &variantsOut,
+		std::vector<FTransform> &transformsOut
+	);
+
+	static float densityFor(ETerrainType type);
+
+private:
+	void blockNodesAround(
+		std::vector<std::vector<FVector>> &map,
+		std::vector<std::vector<bool>> &freeGrid,
+		std::vector<FVector> &blockedLocations
+	);
+};
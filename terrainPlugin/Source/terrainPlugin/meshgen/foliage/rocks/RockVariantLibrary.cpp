@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RockVariantLibrary.h"
+#include "GameCore/MeshGenBase/MeshData/MeshData.h"
+#include "AssetPlugin/gamestart/assetEnums/materialEnum.h"
+#include "terrainPlugin/meshgen/foliage/rocks/RockCreator.h"
+#include "terrainPlugin/meshgen/foliage/instancing/FoliageMeshRegistry.h"
+
+RockVariantLibrary *RockVariantLibrary::instancePointer = nullptr;
+
+void RockVariantLibrary::EndGame(){
+    if(RockVariantLibrary *ptr = instancePointer){
+        delete ptr;
+        RockVariantLibrary::instancePointer = nullptr;
+    }
+}
+
+/// @brief you are not allowed to delete this pointer!
+/// @return instance pointer
+RockVariantLibrary *RockVariantLibrary::instance(){
+    if(RockVariantLibrary::instancePointer == nullptr){
+        RockVariantLibrary::instancePointer = new RockVariantLibrary();
+    }
+    return RockVariantLibrary::instancePointer;
+}
+
+RockVariantLibrary::RockVariantLibrary()
+{
+}
+
+RockVariantLibrary::~RockVariantLibrary()
+{
+    variantIds.clear();
+    halfWidths.clear();
+    heights.clear();
+}
+
+/// @brief seed of a variant, same index always gives the same rock
+int32 RockVariantLibrary::seedFor(int variantIndex){
+    return 104729 + variantIndex * 1000;
+}
+
+/// @brief builds all variants once: size and layers are drawn from the variant seed,
+/// the rock is centered on x and y and sunk a bit so it does not float on slopes
+void RockVariantLibrary::pregenerate(){
+    if(variantIds.size() > 0){
+        return;
+    }
+
+    FoliageMeshRegistry *registry = FoliageMeshRegistry::instance();
+    for (int i = 0; i < VARIANT_COUNT; i++){
+        int32 seed = seedFor(i);
+        FRandomStream random(seed);
+        int sizeX = random.RandRange(300, 600);
+        int sizeY = random.RandRange(300, 600);
+        int layers = random.RandRange(3, 5);
+        int heightStep = random.RandRange(50, 100);
+        int detailStep = 100;
+
+        RockCreator creator;
+        creator.setSeed(seed);
+        MeshData rock = creator.createMesh(sizeX, sizeY, detailStep, layers, heightStep);
+        if(rock.verteciesNum() == 0){
+            continue;
+        }
+
+        //pivot: bottom center, 10 percent below ground
+        TArray<FVector> &vertecies = rock.getVerteciesRef();
+        FVector min = vertecies[0];
+        FVector max = vertecies[0];
+        for (int j = 1; j < vertecies.Num(); j++){
+            min = min.ComponentMin(vertecies[j]);
+            max = max.ComponentMax(vertecies[j]);
+        }
+        float height = max.Z - min.Z;
+        FVector pivot((min.X + max.X) / -2.0f, (min.Y + max.Y) / -2.0f, -min.Z - height * 0.1f);
+        rock.offsetAllvertecies(pivot);
+        rock.setTargetMaterial(materialEnum::stoneMaterial);
+
+        MeshData noLeaf;
+        noLeaf.setTargetMaterial(materialEnum::stoneMaterial);
+        int id = registry->registerVariant(rock, noLeaf, false);
+
+        variantIds.push_back(id);
+        halfWidths[id] = std::max(max.X - min.X, max.Y - min.Y) / 2.0f;
+        heights[id] = height * 0.9f;
+    }
+}
+
+/// @brief picks a variant with the passed stream, generates the variants if needed
+/// @return variant id in the FoliageMeshRegistry or -1 if none
+int RockVariantLibrary::randomVariant(FRandomStream &random){
+    std::vector<int> &ids = variants();
+    if(ids.size() == 0){
+        return -1;
+    }
+    return ids[random.RandRange(0, ids.size() - 1)];
+}
+
+std::vector<int> &RockVariantLibrary::variants(){
+    pregenerate();
+    return variantIds;
+}
+
+/// @brief half extent on x and y of the unscaled rock
+float RockVariantLibrary::halfWidthOf(int variantId){
+    if(halfWidths.find(variantId) != halfWidths.end()){
+        return halfWidths[variantId];
+    }
+    return 0.0f;
+}
+
+/// @brief height above ground of the unscaled rock
+float RockVariantLibrary::heightOf(int variantId){
+    if(heights.find(variantId) != heights.end()){
+        return heights[variantId];
+    }
+    return 0.0f;
+}
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include <map>
+#include <vector>
+
+/**
+ * pre generates VARIANT_COUNT seeded rocks once and shares them for all chunks.
+ * The meshes are stored in the FoliageMeshRegistry (rock as stem, empty leaf),
+ * a placement only selects a variant id and a transform.
+ */
+class TERRAINPLUGIN_API RockVariantLibrary
+{
+public:
+	static RockVariantLibrary *instance();
+	static void EndGame();
+	~RockVariantLibrary();
+
+	static const int VARIANT_COUNT = 6;
+
+	void pregenerate();
+
+	int randomVariant(FRandomStream &random);
+	std::vector<int> &variants();
+
+	float halfWidthOf(int variantId);
+	float heightOf(int variantId);
+
+	static int32 seedFor(int variantIndex);
+
+private:
+	RockVariantLibrary();
+	static class RockVariantLibrary *instancePointer;
+
+	std::vector<int> variantIds;
+	std::map<int, float> halfWidths;
+	std::map<int, float> heights;
+};
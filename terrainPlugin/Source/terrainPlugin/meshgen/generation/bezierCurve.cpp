@@ -58,43 +58,47 @@ void bezierCurve::calculatecurve(
     std::vector<FVector> &output,
     float _einheitsValue
 ){
-    std::vector<FVector2D> vecA;
-    std::vector<FVector2D> vecB;
+    //member buffers keep their capacity, no allocation if the curve is reused
+    anchorsXY.clear();
+    anchorsXZ.clear();
+    anchorsXY.reserve(ref.size());
+    anchorsXZ.reserve(ref.size());
     for (int i = 0; i < ref.size(); i++){
         FVector &current = ref[i];
-        vecA.push_back(FVector2D(current.X, current.Y));
-        vecB.push_back(FVector2D(current.X, current.Z));
+        anchorsXY.push_back(FVector2D(current.X, current.Y));
+        anchorsXZ.push_back(FVector2D(current.X, current.Z));
     }
 
-    TVector<FVector2D> outA;
-    TVector<FVector2D> outB;
+    curveXY.clear();
+    curveXZ.clear();
     calculatecurve(
-        vecA,
-        outA,
+        anchorsXY,
+        curveXY,
         _einheitsValue
     );
     calculatecurve(
-        vecB,
-        outB,
+        anchorsXZ,
+        curveXZ,
         _einheitsValue
     );
 
     //merge
-    int larger = outA.size() > outB.size() ? outA.size() : outB.size();
+    int larger = curveXY.size() > curveXZ.size() ? curveXY.size() : curveXZ.size();
+    output.reserve(output.size() + larger);
     for (int i = 0; i < larger; i++)
     {
         FVector2D currentA;
         FVector2D currentB;
-        if(i < outA.size()){
-            currentA = outA[i];
+        if(i < curveXY.size()){
+            currentA = curveXY[i];
         }else{
-            currentA = outA[outA.size() - 1];
+            currentA = curveXY[curveXY.size() - 1];
         }
 
-        if(i < outB.size()){
-            currentB = outB[i];
+        if(i < curveXZ.size()){
+            currentB = curveXZ[i];
         }else{
-            currentB = outB[outB.size() - 1];
+            currentB = curveXZ[curveXZ.size() - 1];
         }
 
         FVector merge(currentA.X, currentA.Y, currentB.Y);
@@ -131,8 +135,9 @@ void bezierCurve::createContinuityCurve(std::vector<FVector2D> &anchors){
     }
 
 
-    //data will be copied later
-    std::vector<FVector2D> curve;
+    //data will be copied later, member buffer is reused
+    std::vector<FVector2D> &curve = continuityCurve;
+    curve.clear();
 
     float BETAConst = 0.25;
 
@@ -59,6 +59,12 @@ private:
 
 	float EinheitsValue;
 
+	//scratch buffers, reused between calls, keep one curve alive to avoid allocations
+	std::vector<FVector2D> anchorsXY;
+	std::vector<FVector2D> anchorsXZ;
+	std::vector<FVector2D> continuityCurve;
+	TVector<FVector2D> curveXY;
+	TVector<FVector2D> curveXZ;
 
 	void createContinuityCurve(std::vector<FVector2D> &anchors);
 	
@@ -31,6 +31,10 @@ TerrainChunkSetup &TerrainChunkSetup::operator=(TerrainChunkSetup &other){
         savedTerrainType = other.savedTerrainType;
         createOutpost = other.createOutpost;
         blockTrees = other.blockTrees;
+        outpostLocation = other.outpostLocation;
+        freeFoliagePositions = other.freeFoliagePositions;
+        freeFoliageGrid = other.freeFoliageGrid;
+        placementSeed = other.placementSeed;
     }
     return *this;
 }
@@ -42,31 +46,47 @@ TerrainChunkSetup::~TerrainChunkSetup(){
 
 float TerrainChunkSetup::treeDensitySkalar(){
     if(createTrees()){
-        /*
-        EForest,
-        ETropical,
-        EDesert,
-        EDesertForest,
-        EOcean,
-        ESnowHill
-        */
-        // dont go beyond 0.1 
-        float scalar = 0.1f;
-        if(savedTerrainType == ETerrainType::EForest) scalar = 0.1f;
-        if(savedTerrainType == ETerrainType::ETropical) scalar = 0.1f;
-        if(savedTerrainType == ETerrainType::EDesert) scalar = 0.05f;
-        if(savedTerrainType == ETerrainType::EDesertForest) scalar = 0.1f;
-        if(savedTerrainType == ETerrainType::EOcean) scalar = 0.05f;
-        if(savedTerrainType == ETerrainType::ESnowHill) scalar = 0.05f;
-
         //dont use raw number which is for a 100% valid position part
-        float scaledCorrectly = scalar * scaleUpFractionByLeftOverValidPositions();
+        float scaledCorrectly = treeDensityForTerrainType() * scaleUpFractionByLeftOverValidPositions();
         DebugHelper::logMessage("terrain tree fraction scaled up done: ", (float) scaledCorrectly);
         return scaledCorrectly;
     }
     return 0.0f;
 }
 
+/// @brief trees per map node for the terrain type
+float TerrainChunkSetup::treeDensityForTerrainType(){
+    /*
+    EForest,
+    ETropical,
+    EDesert,
+    EDesertForest,
+    EOcean,
+    ESnowHill
+    */
+    // dont go beyond 0.1 
+    float scalar = 0.1f;
+    if(savedTerrainType == ETerrainType::EForest) scalar = 0.1f;
+    if(savedTerrainType == ETerrainType::ETropical) scalar = 0.1f;
+    if(savedTerrainType == ETerrainType::EDesert) scalar = 0.05f;
+    if(savedTerrainType == ETerrainType::EDesertForest) scalar = 0.1f;
+    if(savedTerrainType == ETerrainType::EOcean) scalar = 0.05f;
+    if(savedTerrainType == ETerrainType::ESnowHill) scalar = 0.05f;
+    return scalar;
+}
+
+/// @brief min distance between two trees for the poisson disk placement, derived from
+/// the density: one tree per 1 / density nodes, the disk packing covers about half of it
+/// @return distance in cm, 0 if there is no map
+float TerrainChunkSetup::treeMinDistance(){
+    if(map2D == nullptr || map2D->size() < 2 || (*map2D)[0].size() < 1){
+        return 0.0f;
+    }
+    float nodeDistance = (*map2D)[1][0].X - (*map2D)[0][0].X;
+    float areaPerTree = (nodeDistance * nodeDistance) / treeDensityForTerrainType();
+    return std::sqrt(areaPerTree * 0.5f);
+}
+
 float TerrainChunkSetup::scaleUpFractionByLeftOverValidPositions(){
     //left / all wäre z.b. 1/2, mal percent ist weniger, nicht gewollt,
     //part soll höher skalliert werden um auf gleiche percent zu kommen effektiv
@@ -125,3 +145,19 @@ void TerrainChunkSetup::createOutPostIfFlagged(UWorld *world){
 TArray<FVectorTouple> &TerrainChunkSetup::freeFoliagePositionsRef(){
     return freeFoliagePositions;
 }
+
+/// @brief saves the occupancy grid of the chunk and the seed for the foliage placement
+/// @param freeGridIn true is free, same layout as the map, copied
+/// @param seedIn seed, same chunk same seed
+void TerrainChunkSetup::setFoliagePlacement(std::vector<std::vector<bool>> &freeGridIn, int32 seedIn){
+    freeFoliageGrid = freeGridIn;
+    placementSeed = seedIn;
+}
+
+std::vector<std::vector<bool>> &TerrainChunkSetup::freeFoliageGridRef(){
+    return freeFoliageGrid;
+}
+
+int32 TerrainChunkSetup::foliagePlacementSeed(){
+    return placementSeed;
+}
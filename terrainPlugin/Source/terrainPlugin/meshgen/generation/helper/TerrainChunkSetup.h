@@ -29,8 +29,14 @@ public:
 
     TArray<FVectorTouple> &freeFoliagePositionsRef();
 
+    void setFoliagePlacement(std::vector<std::vector<bool>> &freeGridIn, int32 seedIn);
+    std::vector<std::vector<bool>> &freeFoliageGridRef();
+    int32 foliagePlacementSeed();
+    float treeMinDistance();
+
 private:
     float scaleUpFractionByLeftOverValidPositions();
+    float treeDensityForTerrainType();
 
 
     void setMapReference(std::vector<std::vector<FVector>> &refIn);
@@ -39,6 +45,10 @@ private:
 
     TArray<FVectorTouple> freeFoliagePositions;
 
+    /// @brief copy of the chunk occupancy, true is free, same layout as the map
+    std::vector<std::vector<bool>> freeFoliageGrid;
+    int32 placementSeed = 0;
+
     ETerrainType savedTerrainType = ETerrainType::ETropical;
     bool createOutpost = false;
     bool blockTrees = false;
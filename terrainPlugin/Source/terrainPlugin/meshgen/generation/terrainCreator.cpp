@@ -15,8 +15,11 @@
 
 
 #include "terrainPlugin/meshgen/rooms/roomActor/roomProcedural.h"
-#include "terrainPlugin/meshgen/water/customWaterActor.h"
+#include "terrainPlugin/meshgen/rooms/roomActor/BuildingGenerationJob.h"
+#include "terrainPlugin/meshgen/water/clipmapWaterActor.h"
 #include "terrainPlugin/meshgen/foliage/helper/FVectorShape.h"
+#include "terrainPlugin/meshgen/foliage/TreeVariantLibrary.h"
+#include "terrainPlugin/meshgen/foliage/rocks/RockVariantLibrary.h"
 
 #include "terrainCreator.h"
 
@@ -140,6 +143,9 @@ TerrainChunkSetup terrainCreator::chunk::makeSetupPackage(){
     freePositionsForFoliageLocal(
         package.freeFoliagePositionsRef()
     );
+    //occupancy for the foliage placement, seed only depends on the chunk index
+    int32 seed = (x * 73856093) ^ (y * 19349663);
+    package.setFoliagePlacement(innerMapFreePositions, seed);
 
 
     return package;
@@ -876,6 +882,7 @@ void terrainCreator::createTerrain(
     std::vector<terrainHillSetup> &predefinedHillDataVecFlatArea //flat area
 ){
     worldPointer = world;
+    clipmapWater = nullptr;
 
     int chunks = floor(meters / terrainCreator::CHUNKSIZE); //to chunks
     //int detail = CHUNKSIZE; // 1 by 1 detail
@@ -1448,16 +1455,21 @@ void terrainCreator::createChunkAtIfNotCreatedYet(int x, int y){
 }
 
 
+/// @brief one clipmap water surface follows the player over the whole ocean,
+/// it is spawned with the first ocean chunk, all later chunks share it and only
+/// add their area, the water is only drawn over ocean chunks. The actor is only weakly
+/// referenced, if it was destroyed (level reload) a new one is spawned
+/// @param location bottom left of the ocean chunk, z is the water height
 void terrainCreator::createWaterPaneAt(FVector &location){
-    if(worldPointer != nullptr){
-        int scaleCm = CHUNKSIZE * ONEMETER;
-
-        AcustomWaterActor::createWaterPane(
+    if(worldPointer != nullptr && !clipmapWater.IsValid()){
+        clipmapWater = AclipmapWaterActor::spawnClipmap(
             worldPointer,
-            location,
-            scaleCm
+            location.Z + WATER_HEIGHT_OFFSET
         );
     }
+    if(clipmapWater.IsValid()){
+        clipmapWater->addOceanArea(location, CHUNKSIZE * ONEMETER);
+    }
 }
 
 
@@ -1583,6 +1595,7 @@ void terrainCreator::randomizeTerrainTypes(UWorld *world){
     int sizeOfShape = 10; //Chunks
     int step = 1;
     FVectorShape shape;
+    ShapeArena arena;
 
     int shapeCount = map.size();
 
@@ -1590,7 +1603,7 @@ void terrainCreator::randomizeTerrainTypes(UWorld *world){
 
     for (int i = 0; i < shapeCount; i++){
 
-        shape.createRandomNewSmoothedShapeClamped(sizeOfShape, step);
+        shape.createRandomNewSmoothedShapeClamped(sizeOfShape, step, arena);
         shape.floorAllCoordinateValues(); //macht es quasi eckig
 
         //DEBUG
@@ -1630,7 +1643,7 @@ void terrainCreator::randomizeTerrainTypes(UWorld *world){
         
 
         shape.sortVerteciesOnXAxis();
-        std::vector<FVector> vertecies = shape.vectorCopy();
+        std::vector<FVector> &vertecies = shape.vectorRef();
         
         if(vertecies.size() > 0){
             
@@ -1837,6 +1850,10 @@ void terrainCreator::createTerrainAndCreateBuildings(
 
     randomizeTerrainTypes(world);
     applySpecialTerrainTypesByHeight();
+
+    //shared tree variants, generated once before any chunk spawns
+    TreeVariantLibrary::instance()->pregenerateAll();
+    RockVariantLibrary::instance()->pregenerate();
     
     //recursion issue ? 
     //use this data to create the buildings
@@ -1849,6 +1866,8 @@ void terrainCreator::createTerrainAndCreateBuildings(
     );
     DebugHelper::logMessage("debugterrain chunks found", chunksFound.size());
     
+    //layouts and meshes are built on the workers, only spawning is done here
+    std::vector<BuildingGenerationJob> buildingJobs;
     for (int i = 0; i < chunksFound.size(); i++){
         terrainCreator::chunk *currentPointer = chunksFound[i];
         if(currentPointer != nullptr){
@@ -1858,10 +1877,19 @@ void terrainCreator::createTerrainAndCreateBuildings(
             //create building there.
             int sizeMaxMeters = CHUNKSIZE;
             sizeMaxMeters -= 3;
-            AroomProcedural::generate(world, sizeMaxMeters, sizeMaxMeters, posPivot); //in size is METERS
-
+            buildingJobs.push_back(BuildingGenerationJob(
+                sizeMaxMeters, //in size is METERS
+                sizeMaxMeters,
+                posPivot,
+                ETerrainType::ETropical,
+                std::rand()
+            ));
         }
     }
+    BuildingGenerationJob::runParallel(buildingJobs);
+    for (int i = 0; i < buildingJobs.size(); i++){
+        buildingJobs[i].spawn(world);
+    }
 
     //spawn all - managed via tick(?).
     //applyTerrainDataToMeshActors();
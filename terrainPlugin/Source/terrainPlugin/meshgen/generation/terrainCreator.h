@@ -76,6 +76,7 @@ private:
 
 	static const int HEIGH_AVG_SNOWHILL_LOWERBOUND = 200000; //200 * 100cm
 	static const int HEIGHT_MAX_OCEAN = 200; 
+	static const int WATER_HEIGHT_OFFSET = 100; //same lift as the old water panes
 
 	void createTerrain(UWorld *world, int meters);
 	void createTerrain(
@@ -208,6 +209,7 @@ private:
 	};
 
 	class UWorld *worldPointer = nullptr;
+	TWeakObjectPtr<class AclipmapWaterActor> clipmapWater = nullptr;
 
 	std::vector<std::vector<terrainCreator::chunk>> map;
 
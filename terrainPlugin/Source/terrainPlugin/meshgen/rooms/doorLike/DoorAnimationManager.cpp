@@ -0,0 +1,136 @@
+#include "DoorAnimationManager.h"
+#include "DoorBase.h"
+
+DoorAnimationManager *DoorAnimationManager::instancePointer = nullptr;
+
+void DoorAnimationManager::EndGame(){
+    if(DoorAnimationManager *ptr = instancePointer){
+        delete ptr;
+        DoorAnimationManager::instancePointer = nullptr;
+    }
+}
+
+/// @brief you are not allowed to delete this pointer!
+/// @return instance pointer
+DoorAnimationManager *DoorAnimationManager::instance(){
+    if(DoorAnimationManager::instancePointer == nullptr){
+        DoorAnimationManager::instancePointer = new DoorAnimationManager();
+    }
+    return DoorAnimationManager::instancePointer;
+}
+
+DoorAnimationManager::DoorAnimationManager()
+{
+}
+
+DoorAnimationManager::~DoorAnimationManager()
+{
+    active.clear();
+}
+
+/// @brief starts rotating a door, a running animation of the door is replaced
+/// @param door door to rotate
+/// @param from start rotation
+/// @param to target rotation
+/// @param timeToFrame duration in seconds
+void DoorAnimationManager::animate(ADoorBase *door, FRotator from, FRotator to, float timeToFrame){
+    if(door == nullptr){
+        return;
+    }
+    int index = indexOf(door);
+    if(index < 0){
+        doorAnimation animation;
+        animation.door = door;
+        active.push_back(animation);
+        index = active.size() - 1;
+    }
+
+    TargetInterpolator &interpolator = active[index].interpolator;
+    interpolator.setNewTimeToFrame(timeToFrame); // resets reached flag too
+    interpolator.overrideStart(from);
+    interpolator.overrideTarget(to);
+}
+
+/// @brief removes the door without finishing it, call before the door is destroyed
+void DoorAnimationManager::stop(ADoorBase *door){
+    int index = indexOf(door);
+    if(index >= 0){
+        removeAt(index);
+    }
+}
+
+bool DoorAnimationManager::isAnimating(ADoorBase *door){
+    return indexOf(door) >= 0;
+}
+
+int DoorAnimationManager::activeCount(){
+    return active.size();
+}
+
+/// @brief steps all moving doors, finished doors are notified and removed
+/// @param DeltaTime world delta time, dilated and not advancing while paused
+void DoorAnimationManager::Tick(float DeltaTime){
+    int i = 0;
+    while(i < active.size()){
+        doorAnimation &current = active[i];
+        FRotator rotation = current.interpolator.interpolateRotationOnly(DeltaTime);
+        current.door->SetActorRotation(rotation);
+
+        if(current.interpolator.hasReachedTarget()){
+            ADoorBase *finished = current.door;
+            removeAt(i); //next door is swapped to i
+            finished->animationFinished();
+            continue;
+        }
+        i++;
+    }
+}
+
+/// @brief only asked for IsTickable, nothing runs while no door moves
+ETickableTickType DoorAnimationManager::GetTickableTickType() const{
+    return ETickableTickType::Conditional;
+}
+
+bool DoorAnimationManager::IsTickable() const{
+    return !active.empty();
+}
+
+bool DoorAnimationManager::IsTickableWhenPaused() const{
+    return false;
+}
+
+bool DoorAnimationManager::IsTickableInEditor() const{
+    return false;
+}
+
+/// @brief world of the moving doors, the manager is stepped only by that world
+UWorld *DoorAnimationManager::GetTickableGameObjectWorld() const{
+    if(active.empty() || active[0].door == nullptr){
+        return nullptr;
+    }
+    return active[0].door->GetWorld();
+}
+
+TStatId DoorAnimationManager::GetStatId() const{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(DoorAnimationManager, STATGROUP_Tickables);
+}
+
+int DoorAnimationManager::indexOf(ADoorBase *door){
+    for (int i = 0; i < active.size(); i++){
+        if(active[i].door == door){
+            return i;
+        }
+    }
+    return -1;
+}
+
+void DoorAnimationManager::removeAt(int index){
+    if(index < 0 || index >= active.size()){
+        return;
+    }
+    if(index != active.size() - 1){
+        active[index] = active.back();
+    }
+    active.pop_back();
+}
+
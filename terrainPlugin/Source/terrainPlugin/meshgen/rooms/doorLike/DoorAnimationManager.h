@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "CoreMath/animation/TargetInterpolator.h"
+#include <vector>
+
+class ADoorBase;
+
+/**
+ * steps all moving doors in one update instead of one tick per door.
+ * Only doors which are currently rotating are kept, in a compact array, a finished door
+ * is swap removed. The update is a tickable game object stepped with the world delta time,
+ * it is only tickable while at least one door moves and not while the game is paused,
+ * with no moving door nothing runs at all. Door actors do not tick.
+ */
+class TERRAINPLUGIN_API DoorAnimationManager : public FTickableGameObject
+{
+public:
+    static DoorAnimationManager *instance();
+    static void EndGame();
+    ~DoorAnimationManager();
+
+    void animate(ADoorBase *door, FRotator from, FRotator to, float timeToFrame);
+    void stop(ADoorBase *door);
+    bool isAnimating(ADoorBase *door);
+
+    int activeCount();
+
+    virtual void Tick(float DeltaTime) override;
+    virtual ETickableTickType GetTickableTickType() const override;
+    virtual bool IsTickable() const override;
+    virtual bool IsTickableWhenPaused() const override;
+    virtual bool IsTickableInEditor() const override;
+    virtual UWorld *GetTickableGameObjectWorld() const override;
+    virtual TStatId GetStatId() const override;
+
+private:
+    DoorAnimationManager();
+    static class DoorAnimationManager *instancePointer;
+
+    struct doorAnimation{
+        ADoorBase *door = nullptr;
+        TargetInterpolator interpolator;
+    };
+    std::vector<doorAnimation> active;
+
+    int indexOf(ADoorBase *door);
+    void removeAt(int index);
+};
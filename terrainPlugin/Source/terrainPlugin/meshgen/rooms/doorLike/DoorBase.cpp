@@ -1,4 +1,5 @@
 #include "DoorBase.h"
+#include "DoorAnimationManager.h"
 
 
 ADoorBase *ADoorBase::Construct(UWorld *world, FVector &location){
@@ -22,7 +23,8 @@ ADoorBase *ADoorBase::Construct(UWorld *world, FVector &location){
 
 
 ADoorBase::ADoorBase() : AcustomMeshActor() {
-
+    //animated by the DoorAnimationManager, an idle door has nothing to do
+    PrimaryActorTick.bCanEverTick = false;
 }
 
 void ADoorBase::BeginPlay(){
@@ -30,16 +32,13 @@ void ADoorBase::BeginPlay(){
     initMesh();
 }
 
-void ADoorBase::Tick(float DeltaTime){
-    Super::Tick(DeltaTime);
-    if(!canChangeStateNow()){
-        FRotator rot = interpolator.interpolateRotationOnly(DeltaTime);
-        SetActorRotation(rot);
+void ADoorBase::EndPlay(const EEndPlayReason::Type EndPlayReason){
+    DoorAnimationManager::instance()->stop(this);
+    Super::EndPlay(EndPlayReason);
+}
 
-        if(interpolator.hasReachedTarget()){
-            bIsOpenState = !bIsOpenState; //flip
-        }
-    }
+void ADoorBase::animationFinished(){
+    bIsOpenState = !bIsOpenState; //flip
 }
 
 void ADoorBase::initMesh(){
@@ -80,34 +79,30 @@ void ADoorBase::interact(){
 
 
 void ADoorBase::open(){
-    if(canChangeStateNow()){
-        FRotator currentRotation = GetActorRotation();
-        FRotator nextState = currentRotation;
-        nextState.Yaw += 90.0f;
-
-        interpolator.setNewTimeToFrame(timeOfAnimation);
-        interpolator.overrideStart(currentRotation);
-        interpolator.overrideTarget(nextState);
-        
-    }
+    rotateBy(90.0f);
 }
 
 void ADoorBase::close(){
-    if(canChangeStateNow()){
+    rotateBy(-90.0f);
+}
 
+void ADoorBase::rotateBy(float yawDegrees){
+    if(canChangeStateNow()){
         FRotator currentRotation = GetActorRotation();
         FRotator nextState = currentRotation;
-        nextState.Yaw -= 90.0f;
-
-        interpolator.setNewTimeToFrame(timeOfAnimation); // resets reached flag too
-        interpolator.overrideStart(currentRotation);
-        interpolator.overrideTarget(nextState);
+        nextState.Yaw += yawDegrees;
 
+        DoorAnimationManager::instance()->animate(
+            this,
+            currentRotation,
+            nextState,
+            timeOfAnimation
+        );
     }
 }
 
 
 
 bool ADoorBase::canChangeStateNow(){
-    return interpolator.hasReachedTarget();
+    return !DoorAnimationManager::instance()->isAnimating(this);
 }
\ No newline at end of file
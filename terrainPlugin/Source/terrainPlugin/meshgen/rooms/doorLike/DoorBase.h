@@ -1,7 +1,6 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "CoreMath/animation/TargetInterpolator.h"
 #include "GameCore/interfaces/Interactinterface.h"
 #include "terrainPlugin/meshgen/customMeshActor.h"
 #include "DoorBase.generated.h"
@@ -17,13 +16,16 @@ public:
     static ADoorBase *Construct(UWorld *world, FVector &location);
 
     virtual void BeginPlay() override;
-    virtual void Tick(float DeltaTime) override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     void open();
     void close();
 
     virtual void interact() override;
 
+    /// @brief called by the DoorAnimationManager when the rotation reached its target
+    void animationFinished();
+
 protected:
     virtual void initMesh();
 
@@ -31,7 +33,7 @@ protected:
 
     bool bIsOpenState = false;
 
-    TargetInterpolator interpolator; //es braucht eine rotator direction
-
     float timeOfAnimation = 0.5f;
+
+    void rotateBy(float yawDegrees);
 };
\ No newline at end of file
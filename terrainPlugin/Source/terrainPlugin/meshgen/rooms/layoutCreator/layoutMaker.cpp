@@ -5,6 +5,9 @@
 #include "terrainPlugin/meshgen/rooms/roomActor/roomBoundData.h"
 #include "GameCore/util/FVectorUtil.h"
 #include "terrainPlugin/meshgen/rooms/layoutCreator/layoutMaker.h"
+#include "HAL/PlatformTime.h"
+#include <algorithm>
+#include <set>
 
 layoutMaker::layoutMaker()
 {
@@ -23,6 +26,22 @@ void layoutMaker::clearField(){
     }
     pointerField.clear(); // nur clearen, das feld hat duplikat pointer! kein double deletion, wichtig!
     owningRoomsVec.clear();
+    filledCells = 0;
+}
+
+/// @brief the layout only uses its own random stream from now on,
+/// same seed gives the same doors and windows
+void layoutMaker::setRandomSeed(int32 seed){
+    randomStream.Initialize(seed);
+    useRandomStream = true;
+}
+
+/// @brief same range as FVectorUtil::randomNumber, higher is exclusive
+int layoutMaker::randomNumber(int lower, int higher){
+    if(!useRandomStream){
+        return FVectorUtil::randomNumber(lower, higher);
+    }
+    return randomStream.RandRange(lower, std::max(lower, higher - 1));
 }
 
 void layoutMaker::clearAndFill(int x, int y){
@@ -51,25 +70,7 @@ void layoutMaker::makeLayout(
     }
 
     clearAndFill(xMeters, yMeters);
-
-    int maxIterations = 10000;
-    while(!fieldIsFilled() && maxIterations > 0){
-        
-
-        //create and clamp index
-        int randomI = FVectorUtil::randomNumber(0, possibleSizes.size() - 1);
-        if(randomI >= 0 && randomI < possibleSizes.size()){
-            maxIterations--;
-
-            TTouple<int, int> &t = possibleSizes.at(randomI);
-            int xSizeWanted = t.first();
-            int ySizeWanted = t.last();
-
-            tryFit(xSizeWanted, ySizeWanted);
-        }
-
-        
-    }
+    packLayout(possibleSizes);
 
     createDoorsAndWindows();
 
@@ -118,6 +119,91 @@ void layoutMaker::makeLayout(
  * 
  */
 
+/// @brief deterministic layout, the largest room size which fits anywhere is placed at
+/// its best short side fit (also rotated), until no size fits anymore.
+/// Free space left over is then made to rooms as it is, if it is wide enough.
+/// Each step places one room, so the steps are bounded by the room count.
+void layoutMaker::packLayout(std::vector<TTouple<int, int>> &possibleSizes){
+    if(pointerField.size() <= 0){
+        return;
+    }
+
+    //same bounds as canFit, the last row and column stay free
+    int xSize = pointerField.size() - 1;
+    int ySize = pointerField.at(0).size() - 1;
+    packer.reset(xSize, ySize);
+
+    std::vector<TTouple<int, int>> sizes = possibleSizes;
+    std::sort(sizes.begin(), sizes.end(), [](TTouple<int, int> &a, TTouple<int, int> &b){
+        return a.first() * a.last() > b.first() * b.last();
+    });
+
+    bool placed = true;
+    while(placed){
+        placed = false;
+        for (int i = 0; i < sizes.size() && !placed; i++){
+            int xWanted = sizes[i].first();
+            int yWanted = sizes[i].last();
+
+            int x = 0;
+            int y = 0;
+            int score = 0;
+            bool found = packer.findPosition(xWanted, yWanted, x, y, score);
+
+            int xRotated = 0;
+            int yRotated = 0;
+            int scoreRotated = 0;
+            bool foundRotated = xWanted != yWanted &&
+                packer.findPosition(yWanted, xWanted, xRotated, yRotated, scoreRotated);
+
+            if(foundRotated && (!found || scoreRotated < score)){
+                addRoom(xRotated, yRotated, yWanted, xWanted);
+                placed = true;
+            }else if(found){
+                addRoom(x, y, xWanted, yWanted);
+                placed = true;
+            }
+        }
+    }
+
+    maxRectsPacker::freeRect leftover;
+    while(packer.largestFreeRect(leftover, MIN_ROOM_SIDE)){
+        addRoom(leftover.x, leftover.y, leftover.xScale, leftover.yScale);
+    }
+}
+
+/// @brief old layout, random sizes are fitted at the first free index
+/// until the field is filled or the iterations run out
+void layoutMaker::fitRandom(std::vector<TTouple<int, int>> &possibleSizes){
+    int maxIterations = MAX_RANDOM_ITERATIONS;
+    while(!fieldIsFilled() && maxIterations > 0){
+        
+
+        //create and clamp index
+        int randomI = randomNumber(0, possibleSizes.size() - 1);
+        if(randomI >= 0 && randomI < possibleSizes.size()){
+            maxIterations--;
+
+            TTouple<int, int> &t = possibleSizes.at(randomI);
+            int xSizeWanted = t.first();
+            int ySizeWanted = t.last();
+
+            tryFit(xSizeWanted, ySizeWanted);
+        }
+
+        
+    }
+}
+
+/// @brief creates a room, marks it in the field and in the packer
+void layoutMaker::addRoom(int fromX, int fromY, int xSize, int ySize){
+    int roomNumber = owningRoomsVec.size() + 1;
+    roomBoundData *newRoom = new roomBoundData(fromX, fromY, xSize, ySize, roomNumber);
+    owningRoomsVec.push_back(newRoom); //add to owning vector for later clean up
+    fill(fromX, fromY, xSize, ySize, newRoom);
+    packer.place(fromX, fromY, xSize, ySize);
+}
+
 
 //try fit and do automatically if could
 void layoutMaker::tryFit(int xSize, int ySize){
@@ -166,27 +252,27 @@ void layoutMaker::fill(int fromX, int fromY, int xSize, int ySize, roomBoundData
     for (int i = fromX; i < toX; i++){
         for (int j = fromY; j < toY; j++)
         {
+            if(pointerField.at(i).at(j) == nullptr){
+                filledCells++;
+            }
             pointerField.at(i).at(j) = room;
         }
     }
 }
 
-//muss man noch umschreiben
+/// @brief filled cells are counted in fill, no scan needed
 bool layoutMaker::fieldIsFilled(){
     if(pointerField.size() <= 0){
         return true;
     }
-    for (int i = pointerField.size() - 1; i >= 0; i--){
-        for (int j = pointerField.at(i).size() - 1; j >= 0; j--){
-            if(i >= 0 && j >= 0){
-                if(pointerField[i][j] == nullptr){
-                    return false;
-                }
-            }
-            
-        }
+    return filledCells >= pointerField.size() * pointerField.at(0).size();
+}
+
+float layoutMaker::fillRatio(){
+    if(pointerField.size() <= 0 || pointerField.at(0).size() <= 0){
+        return 0.0f;
     }
-    return true;
+    return filledCells / (float)(pointerField.size() * pointerField.at(0).size());
 }
 
 /**
@@ -195,135 +281,137 @@ bool layoutMaker::fieldIsFilled(){
  * 
  */
 void layoutMaker::createDoorsAndWindows(){
+    adjacency.build(pointerField); //one sweep, shared by doors and windows
     makeDoors();
     makeWindows();
 }
 
+/// @brief one door in the middle of the wall segment of each neighboring room pair
 void layoutMaker::makeDoors(){
-    //alle räume durchgehen
-    //alle seiten abtasten, jede nur eine tür
+    std::set<std::pair<int, int>> connected;
 
-    for (int i = 0; i < owningRoomsVec.size(); i++){
-        roomBoundData *current = owningRoomsVec.at(i);
-        if(current != nullptr){
-            //nur die nächsten befüllen
-            for (int j = i + 1; j < owningRoomsVec.size(); j++){
-                roomBoundData *compared = owningRoomsVec.at(j);
-                if(compared != nullptr){
-                    //current->connectTo(compared);
-                    current->connect(*compared);
-                }
-            }
+    std::vector<roomAdjacency::wallSegment> &segments = adjacency.segmentsRef();
+    for (int i = 0; i < segments.size(); i++){
+        roomAdjacency::wallSegment &current = segments[i];
+        if(!current.isInterior()){
+            continue;
         }
-        
+
+        int a = std::min(current.lower->number, current.upper->number);
+        int b = std::max(current.lower->number, current.upper->number);
+        if(!connected.insert(std::pair<int, int>(a, b)).second){
+            continue;
+        }
+
+        FVector door = current.middle();
+        current.lower->addDoorPosition(door);
+        current.upper->addDoorPosition(door);
     }
 }
 
-
+/// @brief every cell of an outer wall segment is a potential window,
+/// one of them may become a door to the outside
 void layoutMaker::makeWindows(){
-    //go through all rooms and check
+    //potential windows per room, rooms are numbered from 1
+    std::vector<std::vector<FVector>> potentialWindows(owningRoomsVec.size());
+
+    std::vector<roomAdjacency::wallSegment> &segments = adjacency.segmentsRef();
+    for (int i = 0; i < segments.size(); i++){
+        roomAdjacency::wallSegment &current = segments[i];
+        if(current.isInterior()){
+            continue;
+        }
+        roomBoundData *room = current.room();
+        int index = room->number - 1;
+        if(index < 0 || index >= potentialWindows.size()){
+            continue;
+        }
+        for (int cell = current.from; cell <= current.to; cell++){
+            potentialWindows[index].push_back(current.positionAt(cell));
+        }
+    }
+
     for (int i = 0; i < owningRoomsVec.size(); i++){
         roomBoundData *current = owningRoomsVec.at(i);
+        if(current == nullptr || current->number - 1 >= potentialWindows.size()){
+            continue;
+        }
+        std::vector<FVector> &windows = potentialWindows[current->number - 1];
 
-        if(current != nullptr){
-
-            std::vector<FVector> potentialWindows;
-
-            int xcopy = current->xpos();//lower bounds
-            int ycopy = current->ypos();
-
-            int xTo = current->xMax();
-            int yTo = current->yMax();
-
-            //checkFree(xcopy - 1, ycopy - 1, xTo + 1, yTo + 1, potentialWindows);
-            checkFree(xcopy, ycopy, xTo, yTo, potentialWindows);
-
-            bool doorwasAlreadyPlaced = false;
-            for (int pos = 0; pos < potentialWindows.size(); pos++)
-            {
-                int num = (int)(FVectorUtil::randomNumber(0, 10));
-                bool create = true;
-                if (create)
-                {
-                    bool placeDoor = (!doorwasAlreadyPlaced && num > 5);
-
-                    FVector currentWindow = potentialWindows[pos];
-                    if(!placeDoor){
-                        current->addWindowPosition(currentWindow);
-                    }else{
-                        current->addDoorPosition(currentWindow);
-                        doorwasAlreadyPlaced = true;
-                    }
-                }
+        bool doorwasAlreadyPlaced = false;
+        for (int pos = 0; pos < windows.size(); pos++)
+        {
+            int num = randomNumber(0, 10);
+            bool placeDoor = (!doorwasAlreadyPlaced && num > 5);
+
+            FVector &currentWindow = windows[pos];
+            if(!placeDoor){
+                current->addWindowPosition(currentWindow);
+            }else{
+                current->addDoorPosition(currentWindow);
+                doorwasAlreadyPlaced = true;
             }
         }
     }
 }
 
-/// @brief checks if an index is min or max
-/// @param i index to check
-/// @return true or false 
-bool layoutMaker::isOuterEdge(int i){
-    bool b = (i <= 0 || i >= pointerField.size() - 1);
-    return b;
-}
-
-bool layoutMaker::isOuterEdge(int i, int j){
-    return (i <= 0 || i >= pointerField.size() - 1 || 
-            j <= 0 || j >= pointerField[i].size() - 1);
-}
-
-
-/// @brief checks any area for being an edge area, also below or beyond limits
-/// when checking for window positions for a room, decrease lower bound by one, increase higher 
-/// bound by one to scan for neighbors / potential windows properly
-/// @param xf x from
-/// @param yf y from
-/// @param xto x to
-/// @param yto y to
-/// @param output output positions for potential windows. Was either edge of array or was nullptr
-void layoutMaker::checkFree(int xf, int yf, int xto, int yto, std::vector<FVector> &output){
-
-    //alle achsen einmal abgehen
-    //oben und unten
-    
-    for (int i = xf; i < xto; i++){
-        if(canBeWindow(i, yf-1)){
-            output.push_back(FVector(i, yf, 0));
-        }
-        if(canBeWindow(i, yto+1)){
-            output.push_back(FVector(i, yto, 0));
-        }
-    }
-
 
-    for (int i = yf; i < yto; i++){
-        if(canBeWindow(xf-1, i)){
-            output.push_back(FVector(xf, i, 0));
-        }
-        if(canBeWindow(xto+1, i)){
-            output.push_back(FVector(xto, i, 0));
-        }
-    }
 
-}
 
-/// @brief soll eine rand position von einem raum sein, also aktiv im index daneben,
-/// wenn edge, bounds oder null, dann dort mögliche window position
-/// @param i 
-/// @param j 
-/// @return bool is a window position 
-bool layoutMaker::canBeWindow(int i, int j){
-    //edge or out of bounds
-    if(i <= 0 || i >= pointerField.size() - 1)
-        return true;
-    if(j <= 0 || j >= pointerField.at(i).size() - 1)
-        return true;
+/**
+ * 
+ * benchmark section
+ * 
+ */
 
-    if(i >= 0 && j >= 0 && i < pointerField.size() && j < pointerField.at(i).size()){
-        return pointerField.at(i).at(j) == nullptr;
+/// @brief compares the random fitter with the packed layout, same sizes as roomProcedural,
+/// doors and windows are not part of the measurement
+/// @param xMeters footprint x
+/// @param yMeters footprint y
+/// @param runs runs to average
+void layoutMaker::runBenchmark(int xMeters, int yMeters, int runs){
+    runs = std::max(1, runs);
+
+    std::vector<TTouple<int, int>> sizesPossible;
+    sizesPossible.push_back(TTouple<int, int>(xMeters / 2, yMeters / 2));
+    sizesPossible.push_back(TTouple<int, int>(xMeters / 3, yMeters / 3));
+    sizesPossible.push_back(TTouple<int, int>(xMeters / 4, yMeters / 4));
+
+    layoutMaker maker;
+    double randomTime = 0.0;
+    double packedTime = 0.0;
+    float randomRatio = 0.0f;
+    float packedRatio = 0.0f;
+    int randomRooms = 0;
+    int packedRooms = 0;
+
+    for (int i = 0; i < runs; i++){
+        maker.clearAndFill(xMeters, yMeters);
+        double start = FPlatformTime::Seconds();
+        maker.fitRandom(sizesPossible);
+        randomTime += FPlatformTime::Seconds() - start;
+        randomRatio += maker.fillRatio();
+        randomRooms += maker.owningRoomsVec.size();
+
+        maker.clearAndFill(xMeters, yMeters);
+        start = FPlatformTime::Seconds();
+        maker.packLayout(sizesPossible);
+        packedTime += FPlatformTime::Seconds() - start;
+        packedRatio += maker.fillRatio();
+        packedRooms += maker.owningRoomsVec.size();
     }
 
-    return false;
+    FString message = FString::Printf(
+        TEXT("layoutMaker benchmark %d x %d, %d runs: random %.3f ms fill %.2f rooms %.1f, packed %.3f ms fill %.2f rooms %.1f"),
+        xMeters,
+        yMeters,
+        runs,
+        randomTime * 1000.0 / runs,
+        randomRatio / runs,
+        randomRooms / (float)runs,
+        packedTime * 1000.0 / runs,
+        packedRatio / runs,
+        packedRooms / (float)runs
+    );
+    DebugHelper::logMessage(message);
 }
-
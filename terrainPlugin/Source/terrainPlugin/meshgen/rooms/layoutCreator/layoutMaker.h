@@ -4,6 +4,8 @@
 
 
 #include "terrainPlugin/meshgen/rooms/roomActor/roomBoundData.h"
+#include "terrainPlugin/meshgen/rooms/layoutCreator/maxRectsPacker.h"
+#include "terrainPlugin/meshgen/rooms/layoutCreator/roomAdjacency.h"
 #include "GameCore/util/TTouple.h"
 #include "CoreMinimal.h"
 
@@ -23,28 +25,41 @@ public:
 		std::vector<roomBoundData> &output
 	);
 
-	
+	static void runBenchmark(int xMeters, int yMeters, int runs);
+
+	void setRandomSeed(int32 seed);
 
 private:
+	/// leftover free space below this side length is not made a room
+	static const int MIN_ROOM_SIDE = 3;
+	static const int MAX_RANDOM_ITERATIONS = 10000;
+
 	std::vector<std::vector<roomBoundData*>> pointerField;
 	std::vector<roomBoundData *> owningRoomsVec;
+	int filledCells = 0;
+
+	//own stream if seeded, worker threads must not share std::rand
+	FRandomStream randomStream;
+	bool useRandomStream = false;
+	int randomNumber(int lower, int higher);
 	
 	void clearAndFill(int x, int y);
 	void clearField();
 
 	bool fieldIsFilled();
+	float fillRatio();
+
+	maxRectsPacker packer;
+	void packLayout(std::vector<TTouple<int, int>> &possibleSizes);
+	void fitRandom(std::vector<TTouple<int, int>> &possibleSizes);
+	void addRoom(int fromX, int fromY, int xSize, int ySize);
 
 	void tryFit(int xSize, int ySize);
 	bool canFit(int fromX, int fromY, int xSize, int ySize);
 	void fill(int fromX, int fromY, int xSize, int ySize, roomBoundData *room);
 
+	roomAdjacency adjacency;
 	void createDoorsAndWindows();
 	void makeDoors();
-
 	void makeWindows();
-	bool isOuterEdge(int i);
-	bool isOuterEdge(int i, int j);
-
-	void checkFree(int xf, int yf, int xto, int yto, std::vector<FVector> &output);
-	bool canBeWindow(int i, int j);
 };
@@ -0,0 +1,186 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "terrainPlugin/meshgen/rooms/layoutCreator/maxRectsPacker.h"
+#include <algorithm>
+
+maxRectsPacker::maxRectsPacker()
+{
+}
+
+maxRectsPacker::~maxRectsPacker()
+{
+    freeRects.clear();
+}
+
+/// @brief clears the packer, the whole area is one free rectangle
+/// @param xSize size on x in index space
+/// @param ySize size on y in index space
+void maxRectsPacker::reset(int xSize, int ySize){
+    freeRects.clear();
+    usedCells = 0;
+    if(xSize <= 0 || ySize <= 0){
+        return;
+    }
+    freeRect whole;
+    whole.xScale = xSize;
+    whole.yScale = ySize;
+    freeRects.push_back(whole);
+}
+
+int maxRectsPacker::freeRectCount(){
+    return freeRects.size();
+}
+
+int maxRectsPacker::usedArea(){
+    return usedCells;
+}
+
+/// @brief finds the best short side fit for a room, ties go to the smaller
+/// long side, then to the lower x and y so the result is deterministic
+/// @param xSize room size x
+/// @param ySize room size y
+/// @param xOut bottom left x if found
+/// @param yOut bottom left y if found
+/// @param scoreOut short side leftover if found, lower is better
+/// @return found a position or not
+bool maxRectsPacker::findPosition(int xSize, int ySize, int &xOut, int &yOut, int &scoreOut){
+    if(xSize <= 0 || ySize <= 0){
+        return false;
+    }
+
+    bool found = false;
+    int bestShort = 0;
+    int bestLong = 0;
+    for (int i = 0; i < freeRects.size(); i++){
+        freeRect &current = freeRects[i];
+        if(current.xScale < xSize || current.yScale < ySize){
+            continue;
+        }
+        int leftX = current.xScale - xSize;
+        int leftY = current.yScale - ySize;
+        int shortSide = std::min(leftX, leftY);
+        int longSide = std::max(leftX, leftY);
+
+        bool better = !found ||
+            shortSide < bestShort ||
+            (shortSide == bestShort && longSide < bestLong) ||
+            (shortSide == bestShort && longSide == bestLong &&
+                (current.x < xOut || (current.x == xOut && current.y < yOut)));
+
+        if(better){
+            found = true;
+            bestShort = shortSide;
+            bestLong = longSide;
+            xOut = current.x;
+            yOut = current.y;
+        }
+    }
+    scoreOut = bestShort;
+    return found;
+}
+
+/// @brief marks the area as used, the area must be free (found by findPosition)
+void maxRectsPacker::place(int x, int y, int xSize, int ySize){
+    freeRect used;
+    used.x = x;
+    used.y = y;
+    used.xScale = xSize;
+    used.yScale = ySize;
+
+    splitBuffer.clear();
+    for (int i = 0; i < freeRects.size(); i++){
+        freeRect &current = freeRects[i];
+        if(intersects(current, used)){
+            splitFreeRect(current, used, splitBuffer);
+        }else{
+            splitBuffer.push_back(current);
+        }
+    }
+    freeRects.swap(splitBuffer);
+    pruneContained();
+    usedCells += used.area();
+}
+
+/// @brief appends the up to 4 maximal rectangles left of the free rect around the used one
+/// @param free free rect intersecting the used one
+/// @param used used area
+/// @param output vector to append to
+void maxRectsPacker::splitFreeRect(
+    const freeRect &free,
+    const freeRect &used,
+    std::vector<freeRect> &output
+){
+    if(used.x > free.x){
+        freeRect left = free;
+        left.xScale = used.x - free.x;
+        output.push_back(left);
+    }
+    if(used.xMax() < free.xMax()){
+        freeRect right = free;
+        right.x = used.xMax();
+        right.xScale = free.xMax() - used.xMax();
+        output.push_back(right);
+    }
+    if(used.y > free.y){
+        freeRect bottom = free;
+        bottom.yScale = used.y - free.y;
+        output.push_back(bottom);
+    }
+    if(used.yMax() < free.yMax()){
+        freeRect top = free;
+        top.y = used.yMax();
+        top.yScale = free.yMax() - used.yMax();
+        output.push_back(top);
+    }
+}
+
+/// @brief removes free rects which lie completly inside another one
+void maxRectsPacker::pruneContained(){
+    for (int i = 0; i < freeRects.size(); i++){
+        for (int j = i + 1; j < freeRects.size(); j++){
+            if(contains(freeRects[j], freeRects[i])){
+                freeRects.erase(freeRects.begin() + i);
+                i--;
+                break;
+            }
+            if(contains(freeRects[i], freeRects[j])){
+                freeRects.erase(freeRects.begin() + j);
+                j--;
+            }
+        }
+    }
+}
+
+/// @brief largest free rect by area, ties go to the lower x and y
+/// @param output largest rect if found
+/// @param minSide rects with a smaller side are skipped
+/// @return false if nothing is free
+bool maxRectsPacker::largestFreeRect(freeRect &output, int minSide){
+    bool found = false;
+    for (int i = 0; i < freeRects.size(); i++){
+        freeRect &current = freeRects[i];
+        if(current.xScale < minSide || current.yScale < minSide){
+            continue;
+        }
+        bool better = !found ||
+            current.area() > output.area() ||
+            (current.area() == output.area() &&
+                (current.x < output.x || (current.x == output.x && current.y < output.y)));
+        if(better){
+            output = current;
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool maxRectsPacker::intersects(const freeRect &a, const freeRect &b){
+    return a.x < b.xMax() && b.x < a.xMax() &&
+           a.y < b.yMax() && b.y < a.yMax();
+}
+
+bool maxRectsPacker::contains(const freeRect &outer, const freeRect &inner){
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.xMax() <= outer.xMax() && inner.yMax() <= outer.yMax();
+}
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <vector>
+
+/**
+ * maximal rectangles free space structure for the room layout.
+ * The free space is kept as a list of maximal free rectangles (they may overlap),
+ * placing a room splits every free rectangle it touches and removes contained ones.
+ * A fitting position is found by scanning the free rectangles only, not the index grid,
+ * rooms are placed at the best short side fit which keeps the leftover strips wide.
+ */
+class TERRAINPLUGIN_API maxRectsPacker
+{
+public:
+	maxRectsPacker();
+	~maxRectsPacker();
+
+	struct freeRect{
+		int x = 0;
+		int y = 0;
+		int xScale = 0;
+		int yScale = 0;
+
+		int xMax() const { return x + xScale; }
+		int yMax() const { return y + yScale; }
+		int area() const { return xScale * yScale; }
+	};
+
+	void reset(int xSize, int ySize);
+
+	bool findPosition(int xSize, int ySize, int &xOut, int &yOut, int &scoreOut);
+	void place(int x, int y, int xSize, int ySize);
+
+	bool largestFreeRect(freeRect &output, int minSide);
+	int freeRectCount();
+	int usedArea();
+
+private:
+	std::vector<freeRect> freeRects;
+	std::vector<freeRect> splitBuffer; //reused for each placement
+	int usedCells = 0;
+
+	static void splitFreeRect(
+		const freeRect &free,
+		const freeRect &used,
+		std::vector<freeRect> &output
+	);
+	void pruneContained();
+
+	static bool intersects(const freeRect &a, const freeRect &b);
+	static bool contains(const freeRect &outer, const freeRect &inner);
+};
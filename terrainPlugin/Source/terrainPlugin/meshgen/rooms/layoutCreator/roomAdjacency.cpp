@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "terrainPlugin/meshgen/rooms/layoutCreator/roomAdjacency.h"
+
+roomAdjacency::roomAdjacency()
+{
+}
+
+roomAdjacency::~roomAdjacency()
+{
+    segments.clear();
+}
+
+std::vector<roomAdjacency::wallSegment> &roomAdjacency::segmentsRef(){
+    return segments;
+}
+
+/// @brief finds all wall segments of the field, old segments are cleared
+/// @param field index grid, each cell points to its room or nullptr
+void roomAdjacency::build(std::vector<std::vector<roomBoundData *>> &field){
+    segments.clear();
+    if(field.size() <= 0 || field.at(0).size() <= 0){
+        return;
+    }
+    sweep(field, true);
+    sweep(field, false);
+}
+
+/// @brief walks every grid line once, cells outside of the field count as nullptr
+/// @param field index grid
+/// @param alongY true: lines on x (walls along y), false: lines on y
+void roomAdjacency::sweep(
+    std::vector<std::vector<roomBoundData *>> &field,
+    bool alongY
+){
+    int xSize = field.size();
+    int ySize = field.at(0).size();
+    int lineCount = alongY ? xSize : ySize;
+    int cellCount = alongY ? ySize : xSize;
+
+    for (int line = 0; line <= lineCount; line++){
+        bool open = false;
+        wallSegment current;
+
+        for (int cell = 0; cell < cellCount; cell++){
+            roomBoundData *lower = alongY ? cellAt(field, line - 1, cell) : cellAt(field, cell, line - 1);
+            roomBoundData *upper = alongY ? cellAt(field, line, cell) : cellAt(field, cell, line);
+
+            bool continues = open && current.lower == lower && current.upper == upper;
+            if(continues){
+                current.to = cell;
+                continue;
+            }
+            if(open){
+                segments.push_back(current);
+                open = false;
+            }
+            if(lower != upper){
+                current.lower = lower;
+                current.upper = upper;
+                current.alongY = alongY;
+                current.line = line;
+                current.from = cell;
+                current.to = cell;
+                open = true;
+            }
+        }
+        if(open){
+            segments.push_back(current);
+        }
+    }
+}
+
+roomBoundData *roomAdjacency::cellAt(
+    std::vector<std::vector<roomBoundData *>> &field,
+    int x,
+    int y
+){
+    if(x < 0 || x >= field.size()){
+        return nullptr;
+    }
+    std::vector<roomBoundData *> &column = field.at(x);
+    if(y < 0 || y >= column.size()){
+        return nullptr;
+    }
+    return column.at(y);
+}
+
+
+/**
+ *
+ * --- wall segment ---
+ *
+ */
+
+/// @brief both sides are rooms, a door can connect them
+bool roomAdjacency::wallSegment::isInterior() const{
+    return lower != nullptr && upper != nullptr;
+}
+
+/// @brief the room of an outer wall, lower if both are set
+roomBoundData *roomAdjacency::wallSegment::room() const{
+    if(lower != nullptr){
+        return lower;
+    }
+    return upper;
+}
+
+/// @brief position on the wall line in global index space, same as the door positions
+FVector roomAdjacency::wallSegment::positionAt(int cell) const{
+    if(alongY){
+        return FVector(line, cell, 0);
+    }
+    return FVector(cell, line, 0);
+}
+
+FVector roomAdjacency::wallSegment::middle() const{
+    return positionAt((from + to) / 2);
+}
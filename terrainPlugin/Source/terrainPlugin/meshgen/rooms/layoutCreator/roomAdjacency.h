@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "terrainPlugin/meshgen/rooms/roomActor/roomBoundData.h"
+#include <vector>
+
+/**
+ * extracts the shared wall segments of a room layout with one sweep over the index grid.
+ * Every grid line is walked once, neighbouring cells with a different owner extend or start
+ * a segment, so the whole layout costs O(x * y) instead of comparing every room pair.
+ * A segment with a nullptr side is an outer wall (edge of the field or free cells).
+ */
+class TERRAINPLUGIN_API roomAdjacency
+{
+public:
+	roomAdjacency();
+	~roomAdjacency();
+
+	struct wallSegment{
+		roomBoundData *lower = nullptr; //room on the lower index side of the line
+		roomBoundData *upper = nullptr; //room on the higher index side of the line
+		bool alongY = true; //true: wall on x = line, cells from..to on y
+		int line = 0;
+		int from = 0; //first cell, inclusive
+		int to = 0; //last cell, inclusive
+
+		bool isInterior() const;
+		roomBoundData *room() const;
+		FVector positionAt(int cell) const;
+		FVector middle() const;
+	};
+
+	void build(std::vector<std::vector<roomBoundData *>> &field);
+
+	std::vector<wallSegment> &segmentsRef();
+
+private:
+	std::vector<wallSegment> segments;
+
+	void sweep(
+		std::vector<std::vector<roomBoundData *>> &field,
+		bool alongY
+	);
+	static roomBoundData *cellAt(
+		std::vector<std::vector<roomBoundData *>> &field,
+		int x,
+		int y
+	);
+};
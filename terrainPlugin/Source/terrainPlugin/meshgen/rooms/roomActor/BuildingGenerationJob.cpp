@@ -0,0 +1,160 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BuildingGenerationJob.h"
+#include "Async/ParallelFor.h"
+#include "GameCore/util/TTouple.h"
+#include "terrainPlugin/meshgen/rooms/layoutCreator/layoutMaker.h"
+#include "terrainPlugin/meshgen/rooms/roomActor/roomProcedural.h"
+
+BuildingGenerationJob::BuildingGenerationJob()
+{
+}
+
+BuildingGenerationJob::BuildingGenerationJob(
+    int sizeXMetersIn,
+    int sizeYMetersIn,
+    FVector locationIn,
+    ETerrainType terrainTypeIn,
+    int32 seedIn
+){
+    sizeXMeters = sizeXMetersIn;
+    sizeYMeters = sizeYMetersIn;
+    location = locationIn;
+    terrainType = terrainTypeIn;
+    seedSaved = seedIn;
+}
+
+BuildingGenerationJob::BuildingGenerationJob(const BuildingGenerationJob &other){
+    *this = other;
+}
+
+BuildingGenerationJob &BuildingGenerationJob::operator=(const BuildingGenerationJob &other){
+    if(this == &other){
+        return *this;
+    }
+    sizeXMeters = other.sizeXMeters;
+    sizeYMeters = other.sizeYMeters;
+    location = other.location;
+    terrainType = other.terrainType;
+    seedSaved = other.seedSaved;
+    done = other.done;
+    rooms = other.rooms;
+    layerCounts = other.layerCounts;
+    signatures = other.signatures;
+    prefabs = other.prefabs;
+    return *this;
+}
+
+BuildingGenerationJob::~BuildingGenerationJob()
+{
+}
+
+bool BuildingGenerationJob::isDone(){
+    return done;
+}
+
+int BuildingGenerationJob::roomCount(){
+    return rooms.size();
+}
+
+/// @brief fits the layout and computes the prefab signature of every room,
+/// safe to call from any thread: no shared state is touched
+void BuildingGenerationJob::execute(){
+    rooms.clear();
+    layerCounts.clear();
+    signatures.clear();
+    prefabs.clear();
+
+    std::vector<TTouple<int, int>> sizesPossible;
+    sizesPossible.push_back(TTouple<int, int>(sizeXMeters / 2, sizeYMeters / 2));
+    sizesPossible.push_back(TTouple<int, int>(sizeXMeters / 3, sizeYMeters / 3));
+    sizesPossible.push_back(TTouple<int, int>(sizeXMeters / 4, sizeYMeters / 4));
+
+    layoutMaker maker;
+    maker.setRandomSeed(seedSaved);
+    maker.makeLayout(sizeXMeters, sizeYMeters, sizesPossible, rooms);
+
+    //1 or 2 layers like AroomProcedural::createRoom
+    FRandomStream random(seedSaved + 1);
+    std::vector<materialEnum> materials = AroomProcedural::prefabMaterials();
+    layerCounts.resize(rooms.size());
+    signatures.resize(rooms.size());
+    for (int i = 0; i < rooms.size(); i++){
+        layerCounts[i] = random.RandRange(1, 2);
+        BuildingPrefabCache::signatureFor(
+            rooms[i],
+            AroomProcedural::ONE_METER,
+            layerCounts[i],
+            materials,
+            terrainType,
+            signatures[i]
+        );
+    }
+    done = true;
+}
+
+/// @brief spawns the room actors and uploads the built meshes, game thread only
+/// @param world world to spawn in
+void BuildingGenerationJob::spawn(UWorld *world){
+    if(!done || world == nullptr){
+        return;
+    }
+    AroomProcedural::spawnRoomsFromPrefabs(
+        world,
+        location,
+        rooms,
+        prefabs,
+        terrainType
+    );
+}
+
+/// @brief executes all jobs on the task graph workers, resolves their prefabs and returns
+/// when all are built, the results stay in the jobs and are spawned by the caller.
+/// Call from the game thread, the prefab cache is not thread safe.
+/// @param jobs jobs to execute
+void BuildingGenerationJob::runParallel(std::vector<BuildingGenerationJob> &jobs){
+    ParallelFor(jobs.size(), [&jobs](int32 index){
+        jobs[index].execute();
+    });
+    resolvePrefabs(jobs);
+}
+
+/// @brief looks up every room signature in the prefab cache on the calling thread,
+/// a new entry is created for each layout missed and only those are built on the workers.
+/// Every built layout is owned by exactly one room, so the builds do not share any data.
+/// @param jobs executed jobs
+void BuildingGenerationJob::resolvePrefabs(std::vector<BuildingGenerationJob> &jobs){
+    BuildingPrefabCache *cache = BuildingPrefabCache::instance();
+
+    //job and room index of the room which builds a missing prefab
+    std::vector<TTouple<int, int>> toBuild;
+    for (int i = 0; i < jobs.size(); i++){
+        BuildingGenerationJob &job = jobs[i];
+        if(!job.done){
+            continue;
+        }
+        job.prefabs.resize(job.rooms.size());
+        for (int j = 0; j < job.rooms.size(); j++){
+            BuildingPrefabCache::prefab *found = cache->find(job.signatures[j]);
+            if(found == nullptr){
+                found = &cache->create(job.signatures[j]);
+                toBuild.push_back(TTouple<int, int>(i, j));
+            }
+            job.prefabs[j] = found;
+        }
+    }
+
+    ParallelFor(toBuild.size(), [&jobs, &toBuild](int32 index){
+        BuildingGenerationJob &job = jobs[toBuild[index].first()];
+        int room = toBuild[index].last();
+        AroomProcedural::buildRoomPrefab(
+            job.rooms[room],
+            AroomProcedural::ONE_METER,
+            job.layerCounts[room],
+            *job.prefabs[room]
+        );
+    });
+
+    cache->logStats();
+}
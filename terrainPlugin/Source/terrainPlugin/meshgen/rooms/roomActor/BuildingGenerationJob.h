@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameCore/MeshGenBase/foliage/ETerrainType.h"
+#include "terrainPlugin/meshgen/rooms/roomActor/roomBoundData.h"
+#include "terrainPlugin/meshgen/rooms/roomActor/helper/BuildingPrefabCache.h"
+#include <vector>
+
+/**
+ * one building split into a pure data stage and a game thread stage.
+ * execute fits the layout and computes the prefab signature of every room,
+ * it owns its random stream and touches no actor or world, so jobs can run on worker threads.
+ * runParallel then looks the signatures up in the BuildingPrefabCache on the calling thread
+ * and builds only the layouts not seen before, rooms with the same layout share one prefab.
+ * spawn is the thin game thread part: it spawns the room actors and uploads the prefabs.
+ */
+class TERRAINPLUGIN_API BuildingGenerationJob
+{
+public:
+	BuildingGenerationJob();
+	BuildingGenerationJob(
+		int sizeXMetersIn,
+		int sizeYMetersIn,
+		FVector locationIn,
+		ETerrainType terrainTypeIn,
+		int32 seedIn
+	);
+	BuildingGenerationJob(const BuildingGenerationJob &other);
+	BuildingGenerationJob &operator=(const BuildingGenerationJob &other);
+	~BuildingGenerationJob();
+
+	void execute();
+	void spawn(UWorld *world);
+
+	bool isDone();
+	int roomCount();
+
+	static void runParallel(std::vector<BuildingGenerationJob> &jobs);
+
+private:
+	static void resolvePrefabs(std::vector<BuildingGenerationJob> &jobs);
+
+	int sizeXMeters = 0;
+	int sizeYMeters = 0;
+	FVector location;
+	ETerrainType terrainType = ETerrainType::ETropical;
+	int32 seedSaved = 0;
+	bool done = false;
+
+	std::vector<roomBoundData> rooms;
+	std::vector<int> layerCounts;
+	std::vector<std::vector<int>> signatures;
+
+	//owned by the BuildingPrefabCache, shared between rooms and jobs
+	std::vector<BuildingPrefabCache::prefab *> prefabs;
+};
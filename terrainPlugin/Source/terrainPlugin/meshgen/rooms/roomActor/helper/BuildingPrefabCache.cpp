@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BuildingPrefabCache.h"
+#include "GameCore/DebugHelper.h"
+
+BuildingPrefabCache *BuildingPrefabCache::instancePointer = nullptr;
+
+void BuildingPrefabCache::EndGame(){
+    if(BuildingPrefabCache *ptr = instancePointer){
+        delete ptr;
+        BuildingPrefabCache::instancePointer = nullptr;
+    }
+}
+
+/// @brief you are not allowed to delete this pointer!
+/// @return instance pointer
+BuildingPrefabCache *BuildingPrefabCache::instance(){
+    if(BuildingPrefabCache::instancePointer == nullptr){
+        BuildingPrefabCache::instancePointer = new BuildingPrefabCache();
+    }
+    return BuildingPrefabCache::instancePointer;
+}
+
+BuildingPrefabCache::BuildingPrefabCache()
+{
+}
+
+BuildingPrefabCache::~BuildingPrefabCache()
+{
+    prefabMap.clear();
+}
+
+int BuildingPrefabCache::num(){
+    return prefabMap.size();
+}
+
+/// @brief writes everything the room mesh depends on into one int sequence
+/// @param room room layout, door and window positions are in local space
+/// @param oneMeter cm per index
+/// @param layers stacked layers of the room
+/// @param materials material set of the mesh layers
+/// @param terrainType terrain the room is located in
+/// @param output signature, cleared first
+void BuildingPrefabCache::signatureFor(
+    roomBoundData &room,
+    int oneMeter,
+    int layers,
+    std::vector<materialEnum> &materials,
+    ETerrainType terrainType,
+    std::vector<int> &output
+){
+    output.clear();
+    output.push_back(room.xScale());
+    output.push_back(room.yScale());
+    output.push_back(oneMeter);
+    output.push_back(layers);
+    output.push_back((int)terrainType);
+
+    output.push_back(materials.size());
+    for (int i = 0; i < materials.size(); i++){
+        output.push_back((int)materials[i]);
+    }
+
+    //order is kept, the walls are built in this order
+    std::vector<FVector> doors = room.relativeDoorPositionsCm(oneMeter);
+    output.push_back(doors.size());
+    for (int i = 0; i < doors.size(); i++){
+        output.push_back((int)doors[i].X);
+        output.push_back((int)doors[i].Y);
+    }
+
+    std::vector<FVector> windows = room.relativeWindowPositionsCm(oneMeter);
+    output.push_back(windows.size());
+    for (int i = 0; i < windows.size(); i++){
+        output.push_back((int)windows[i].X);
+        output.push_back((int)windows[i].Y);
+    }
+}
+
+/// @brief finds the prefab for a signature
+/// @return prefab or nullptr if not built yet
+BuildingPrefabCache::prefab *BuildingPrefabCache::find(std::vector<int> &signature){
+    auto it = prefabMap.find(signature);
+    if(it != prefabMap.end()){
+        hitCount++;
+        return &it->second;
+    }
+    missCount++;
+    return nullptr;
+}
+
+/// @brief creates an empty prefab to record into, an existing entry is returned as is
+/// @return prefab reference, stays valid until EndGame
+BuildingPrefabCache::prefab &BuildingPrefabCache::create(std::vector<int> &signature){
+    auto it = prefabMap.find(signature);
+    if(it != prefabMap.end()){
+        return it->second;
+    }
+    prefab &created = prefabMap[signature];
+    created.signature = signature;
+    return created;
+}
+
+void BuildingPrefabCache::logStats(){
+    FString message = FString::Printf(
+        TEXT("BuildingPrefabCache prefabs %d hits %d misses %d"),
+        num(),
+        hitCount,
+        missCount
+    );
+    DebugHelper::logMessage(message);
+}
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameCore/MeshGenBase/MeshData/MeshData.h"
+#include "GameCore/MeshGenBase/foliage/ETerrainType.h"
+#include "GameCore/util/TTouple.h"
+#include "AssetPlugin/gamestart/assetEnums/materialEnum.h"
+#include "terrainPlugin/meshgen/rooms/roomActor/roomBoundData.h"
+#include <map>
+#include <vector>
+
+/**
+ * built room meshes shared by all rooms with the same layout.
+ * The key is the signature of the layout output (scale, door and window positions,
+ * layer count) and the material set itself, entries are never replaced, so a prefab
+ * pointer stays valid and belongs to exactly one layout.
+ * A prefab holds the mesh layers in actor space, the door spawns and the glass pane ranges,
+ * a room which hits the cache only copies them, its location is the actor transform.
+ */
+class TERRAINPLUGIN_API BuildingPrefabCache
+{
+public:
+	static BuildingPrefabCache *instance();
+	static void EndGame();
+	~BuildingPrefabCache();
+
+	struct doorSpawn{
+		FVector location; //actor space
+		FRotator rotation;
+	};
+
+	struct prefab{
+		std::vector<int> signature;
+		MeshData floorAndRoof;
+		MeshData walls;
+		MeshData windows;
+		std::vector<TTouple<int, int>> paneRanges; //vertex start and count in windows
+		std::vector<doorSpawn> doors;
+	};
+
+	static void signatureFor(
+		roomBoundData &room,
+		int oneMeter,
+		int layers,
+		std::vector<materialEnum> &materials,
+		ETerrainType terrainType,
+		std::vector<int> &output
+	);
+
+	prefab *find(std::vector<int> &signature);
+	prefab &create(std::vector<int> &signature);
+
+	int num();
+	void logStats();
+
+private:
+	BuildingPrefabCache();
+	static class BuildingPrefabCache *instancePointer;
+
+	std::map<std::vector<int>, prefab> prefabMap;
+	int hitCount = 0;
+	int missCount = 0;
+};
@@ -0,0 +1,120 @@
+
+#include "CoreMinimal.h"
+#include "GlassPaneTable.h"
+#include <cmath>
+
+GlassPaneTable::GlassPaneTable(){
+
+}
+
+GlassPaneTable::~GlassPaneTable(){
+    clear();
+}
+
+void GlassPaneTable::clear(){
+    panes.clear();
+    cells.clear();
+}
+
+int GlassPaneTable::num(){
+    return panes.size();
+}
+
+bool GlassPaneTable::isEmpty(){
+    return panes.empty();
+}
+
+/// @brief adds a pane, the bounds are taken from its vertecies
+/// @param vertexStart first vertex of the pane in the layer
+/// @param vertexCount vertex count of the pane
+/// @param vertecies vertecies of the layer, already in their final local position
+/// @return index of the pane or -1 if the range is invalid
+int GlassPaneTable::addPane(int vertexStart, int vertexCount, TArray<FVector> &vertecies){
+    if(vertexStart < 0 || vertexCount <= 0 || vertexStart + vertexCount > vertecies.Num()){
+        return -1;
+    }
+
+    glassPane pane;
+    pane.vertexStart = vertexStart;
+    pane.vertexCount = vertexCount;
+    pane.min = vertecies[vertexStart];
+    pane.max = vertecies[vertexStart];
+    for (int i = vertexStart + 1; i < vertexStart + vertexCount; i++){
+        pane.min = pane.min.ComponentMin(vertecies[i]);
+        pane.max = pane.max.ComponentMax(vertecies[i]);
+    }
+
+    int index = panes.size();
+    panes.push_back(pane);
+
+    //register in every cell the pane touches
+    FVector tolerance(HIT_TOLERANCE, HIT_TOLERANCE, HIT_TOLERANCE);
+    FVector lower = pane.min - tolerance;
+    FVector upper = pane.max + tolerance;
+    for (int x = cellIndex(lower.X); x <= cellIndex(upper.X); x++){
+        for (int y = cellIndex(lower.Y); y <= cellIndex(upper.Y); y++){
+            for (int z = cellIndex(lower.Z); z <= cellIndex(upper.Z); z++){
+                cells[cellKey(x, y, z)].push_back(index);
+            }
+        }
+    }
+    return index;
+}
+
+/// @brief finds the pane at a local hit, only the panes of the hit cell are checked
+/// @param localHit hit in actor space
+/// @return pane index or -1 if no intact pane was hit
+int GlassPaneTable::findPaneAt(FVector &localHit){
+    int64 key = cellKey(cellIndex(localHit.X), cellIndex(localHit.Y), cellIndex(localHit.Z));
+    auto it = cells.find(key);
+    if(it == cells.end()){
+        return -1;
+    }
+
+    std::vector<int> &candidates = it->second;
+    for (int i = 0; i < candidates.size(); i++){
+        glassPane &pane = panes[candidates[i]];
+        if(!pane.broken && isInside(pane, localHit)){
+            return candidates[i];
+        }
+    }
+    return -1;
+}
+
+/// @brief collapses the vertecies of the pane to its center, the triangles
+/// stay but have no area anymore. Only the range of this pane is touched.
+/// @param paneIndex pane to break
+/// @param vertecies vertecies of the layer
+/// @return true if the pane was broken now, false if invalid or already broken
+bool GlassPaneTable::breakPane(int paneIndex, TArray<FVector> &vertecies){
+    if(paneIndex < 0 || paneIndex >= panes.size()){
+        return false;
+    }
+    glassPane &pane = panes[paneIndex];
+    if(pane.broken || pane.vertexStart + pane.vertexCount > vertecies.Num()){
+        return false;
+    }
+
+    FVector center = (pane.min + pane.max) / 2.0f;
+    for (int i = pane.vertexStart; i < pane.vertexStart + pane.vertexCount; i++){
+        vertecies[i] = center;
+    }
+    pane.broken = true;
+    return true;
+}
+
+bool GlassPaneTable::isInside(glassPane &pane, FVector &localHit){
+    return localHit.X >= pane.min.X - HIT_TOLERANCE && localHit.X <= pane.max.X + HIT_TOLERANCE &&
+           localHit.Y >= pane.min.Y - HIT_TOLERANCE && localHit.Y <= pane.max.Y + HIT_TOLERANCE &&
+           localHit.Z >= pane.min.Z - HIT_TOLERANCE && localHit.Z <= pane.max.Z + HIT_TOLERANCE;
+}
+
+int GlassPaneTable::cellIndex(float value){
+    return (int)std::floor(value / CELL_SIZE);
+}
+
+/// @brief packs 3 cell indices into one key, 21 bits each
+int64 GlassPaneTable::cellKey(int x, int y, int z){
+    const int64 mask = 0x1FFFFF;
+    return ((x & mask) << 42) | ((y & mask) << 21) | (z & mask);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <vector>
+#include <unordered_map>
+
+/**
+ * pane table for the merged glass layer of a mesh actor.
+ * Each pane keeps its vertex sub range and bounds in the layer, the panes are hashed into
+ * a uniform grid of cells so a hit is resolved to its pane by looking up one cell.
+ * Breaking a pane only collapses its own vertex range, the triangle buffer stays as it is,
+ * so the layer can be refreshed (UpdateMeshSection) instead of recreated.
+ */
+class TERRAINPLUGIN_API GlassPaneTable{
+
+public:
+	GlassPaneTable();
+	~GlassPaneTable();
+
+	void clear();
+
+	int addPane(int vertexStart, int vertexCount, TArray<FVector> &vertecies);
+	int findPaneAt(FVector &localHit);
+	bool breakPane(int paneIndex, TArray<FVector> &vertecies);
+
+	int num();
+	bool isEmpty();
+
+private:
+	static constexpr float CELL_SIZE = 100.0f;
+	static constexpr float HIT_TOLERANCE = 10.0f; //panes are flat, a hit may be slightly off
+
+	struct glassPane{
+		int vertexStart = 0;
+		int vertexCount = 0;
+		FVector min;
+		FVector max;
+		bool broken = false;
+	};
+
+	std::vector<glassPane> panes;
+	std::unordered_map<int64, std::vector<int>> cells;
+
+	bool isInside(glassPane &pane, FVector &localHit);
+
+	static int cellIndex(float value);
+	static int64 cellKey(int x, int y, int z);
+};
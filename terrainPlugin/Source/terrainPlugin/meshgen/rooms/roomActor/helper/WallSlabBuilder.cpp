@@ -0,0 +1,174 @@
+
+#include "CoreMinimal.h"
+#include "WallSlabBuilder.h"
+#include <algorithm>
+
+/// @brief creates the builder for one wall
+/// @param from wall start, bottom
+/// @param to wall end, bottom
+/// @param thicknessIn wall thickness, the slab extends to the wall direction turned by 90 degrees
+/// @param heightIn wall height
+WallSlabBuilder::WallSlabBuilder(FVector &from, FVector &to, float thicknessIn, float heightIn){
+    origin = from;
+    FVector connect = to - from;
+    connect.Z = 0.0f;
+    length = connect.Size();
+    direction = connect.GetSafeNormal();
+    side = FVector(-direction.Y, direction.X, 0.0f);
+    thickness = std::abs(thicknessIn);
+    height = std::abs(heightIn);
+}
+
+WallSlabBuilder::~WallSlabBuilder(){
+    openings.clear();
+}
+
+/// @brief adds a full height opening, overlapping openings are merged when building
+/// @param along start of the opening along the wall
+/// @param width width along the wall
+void WallSlabBuilder::addOpening(float along, float width){
+    opening o;
+    o.start = along;
+    o.end = along + std::abs(width);
+    openings.push_back(o);
+}
+
+/// @brief adds a full height opening starting at a position on the wall
+/// @param position position on the wall, same space as from and to
+/// @param width width along the wall
+void WallSlabBuilder::addOpeningAt(FVector &position, float width){
+    FVector offset = position - origin;
+    float along = offset.X * direction.X + offset.Y * direction.Y;
+    addOpening(along, width);
+}
+
+/// @brief appends the wall to the mesh, the output is not cleared
+/// @param output mesh to append to
+void WallSlabBuilder::build(MeshData &output){
+    if(length <= 0.0f || height <= 0.0f){
+        return;
+    }
+
+    std::vector<opening> merged;
+    mergeOpenings(merged);
+
+    vertecies.Empty();
+    triangles.Empty();
+
+    //solid runs between the openings
+    float cursor = 0.0f;
+    for (int i = 0; i < merged.size(); i++){
+        if(merged[i].start > cursor){
+            appendSolid(cursor, merged[i].start);
+        }
+        cursor = merged[i].end;
+    }
+    if(cursor < length){
+        appendSolid(cursor, length);
+    }
+
+    //one join for the whole wall, normals and bounds are updated once
+    MeshData slab(MoveTemp(vertecies), MoveTemp(triangles));
+    output.append(slab);
+}
+
+/// @brief clamps the openings to the wall, sorts them and merges overlapping ones,
+/// solid parts smaller than MIN_SOLID_CM are given to the opening
+void WallSlabBuilder::mergeOpenings(std::vector<opening> &output){
+    output.clear();
+
+    std::vector<opening> sorted;
+    for (int i = 0; i < openings.size(); i++){
+        opening o = openings[i];
+        o.start = std::max(0.0f, o.start);
+        o.end = std::min(length, o.end);
+        if(o.end - o.start > 0.0f){
+            sorted.push_back(o);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const opening &a, const opening &b){
+        return a.start < b.start;
+    });
+
+    for (int i = 0; i < sorted.size(); i++){
+        opening &current = sorted[i];
+        if(!output.empty() && current.start <= output.back().end + MIN_SOLID_CM){
+            opening &last = output.back();
+            last.end = std::max(last.end, current.end);
+        }else{
+            output.push_back(current);
+        }
+    }
+
+    if(!output.empty()){
+        if(output.front().start < MIN_SOLID_CM){
+            output.front().start = 0.0f;
+        }
+        if(output.back().end > length - MIN_SOLID_CM){
+            output.back().end = length;
+        }
+    }
+}
+
+FVector WallSlabBuilder::pointAt(float along, float z, float depth){
+    return origin + direction * along + side * depth + FVector(0.0f, 0.0f, z);
+}
+
+/// @brief 4 shared vertecies and 2 triangles, same winding as MeshData::append(a, b, c, d)
+void WallSlabBuilder::appendQuad(FVector a, FVector b, FVector c, FVector d){
+    int32 offset = vertecies.Num();
+    vertecies.Add(a);
+    vertecies.Add(b);
+    vertecies.Add(c);
+    vertecies.Add(d);
+
+    triangles.Add(offset);
+    triangles.Add(offset + 1);
+    triangles.Add(offset + 2);
+
+    triangles.Add(offset);
+    triangles.Add(offset + 2);
+    triangles.Add(offset + 3);
+}
+
+/**
+ *
+ * --- faces ---
+ * winding like MeshData::appendCube with the bottom ring
+ * (along, depth): a(s0, 0) b(s1, 0) c(s1, thickness) d(s0, thickness)
+ *
+ */
+
+/// @brief one solid run from s0 to s1 along the wall, full height, without bottom
+void WallSlabBuilder::appendSolid(float s0, float s1){
+    //front and back
+    appendQuad(pointAt(s1, 0, 0), pointAt(s1, height, 0), pointAt(s0, height, 0), pointAt(s0, 0, 0));
+    appendQuad(
+        pointAt(s0, 0, thickness),
+        pointAt(s0, height, thickness),
+        pointAt(s1, height, thickness),
+        pointAt(s1, 0, thickness)
+    );
+
+    //caps, the one at s0 faces against the wall direction
+    appendQuad(
+        pointAt(s0, 0, 0),
+        pointAt(s0, height, 0),
+        pointAt(s0, height, thickness),
+        pointAt(s0, 0, thickness)
+    );
+    appendQuad(
+        pointAt(s1, 0, thickness),
+        pointAt(s1, height, thickness),
+        pointAt(s1, height, 0),
+        pointAt(s1, 0, 0)
+    );
+
+    //top
+    appendQuad(
+        pointAt(s0, height, 0),
+        pointAt(s1, height, 0),
+        pointAt(s1, height, thickness),
+        pointAt(s0, height, thickness)
+    );
+}
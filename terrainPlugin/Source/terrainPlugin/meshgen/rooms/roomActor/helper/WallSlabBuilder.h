@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameCore/MeshGenBase/MeshData/MeshData.h"
+#include <vector>
+
+/**
+ * builds one wall segment as a slab with its full height openings (doors, windows) cut
+ * analytically. The wall is split into solid runs between the openings, each run is a box
+ * without bottom: front, back, the caps at its ends and the top. The bottom sits on the floor.
+ * Quads share their 4 vertecies, no matrix is needed, the side direction is the wall
+ * direction turned by 90 degrees.
+ */
+class TERRAINPLUGIN_API WallSlabBuilder{
+
+public:
+	WallSlabBuilder(FVector &from, FVector &to, float thicknessIn, float heightIn);
+	~WallSlabBuilder();
+
+	void addOpening(float along, float width);
+	void addOpeningAt(FVector &position, float width);
+
+	void build(MeshData &output);
+
+private:
+	/// @brief smaller solid parts are merged into the opening next to them
+	static constexpr float MIN_SOLID_CM = 10.0f;
+
+	struct opening{
+		float start;
+		float end;
+	};
+
+	FVector origin;
+	FVector direction;
+	FVector side;
+	float length = 0.0f;
+	float thickness = 0.0f;
+	float height = 0.0f;
+
+	std::vector<opening> openings;
+
+	TArray<FVector> vertecies;
+	TArray<int32> triangles;
+
+	void mergeOpenings(std::vector<opening> &output);
+	void appendSolid(float s0, float s1);
+
+	FVector pointAt(float along, float z, float depth);
+	void appendQuad(FVector a, FVector b, FVector c, FVector d);
+};
@@ -106,82 +106,112 @@ void StaircaseBoundData::setSlope(int i, int j, FVector2D &dir){
  * helper for creating the vertecies
  */
 
-///@brief creates staircase subpart and appends it into the meshdata,
-///updates the passed height offset
-void StaircaseBoundData::Stair::appendData(
-    int oneMeter, 
-    int slopeMeter, 
-    MeshData &outdata,
-    FVector &heightOffset
-){
-    if(!isNone){ //skip if none
-        MMatrix heightOffsetMat(heightOffset);
-
-        std::vector<FVector> quad = orientedAndMovedQuad(oneMeter);
-
-        //move up.
-        if(!isFlat){
-            quad[1].Z += slopeMeter;
-            quad[2].Z += slopeMeter;
-            heightOffset.Z += slopeMeter;
-        }
-
-        for (int i = 0; i < quad.size(); i++){
-            quad[i] = heightOffsetMat * quad[i]; //doesnt seem to work
-        }
+///@brief returns the step quad for a direction, the template is created on first use
+///and only moved for each step afterwards
+std::vector<FVector> &StaircaseBoundData::templateFor(int oneMeter, FVector2D &direction){
+    if(stepTemplatesOneMeter != oneMeter){
+        stepTemplates.clear();
+        stepTemplatesOneMeter = oneMeter;
+    }
 
-        outdata.appendDoublesided(
-            quad[0],
-            quad[1],
-            quad[2],
-            quad[3]
-        );
+    //directions are axis aligned: -1, 0 or 1 per axis
+    int key = (FMath::RoundToInt(direction.X) + 1) * 3 + FMath::RoundToInt(direction.Y) + 1;
+    auto it = stepTemplates.find(key);
+    if(it != stepTemplates.end()){
+        return it->second;
     }
+    std::vector<FVector> &created = stepTemplates[key];
+    createStepTemplate(oneMeter, direction, created);
+    return created;
 }
 
-///@brief creates the quad in the given meter size and correct orientation
-///aswell as the local transform in the array, scaled up to the given meter scale
-std::vector<FVector> StaircaseBoundData::Stair::orientedAndMovedQuad(int oneMeter){
-    std::vector<FVector> quad = {
-        FVector(0, 0, 0),               // v0
-        FVector(oneMeter, 0, 0),        // v1
-        FVector(oneMeter, oneMeter, 0), // v2
-        FVector(0, oneMeter, 0),        // v3
-    };
-
-    //to center, rotate around center of mass
-    FVector toCenter(-oneMeter / 2.0f, -oneMeter / 2.0f, 0);
-    MMatrix toCenterMat(toCenter);
-    for (int i = 0; i < quad.size(); i++){
-        quad[i] = toCenterMat * quad[i];
-    }
+///@brief creates the step quad in the given meter size, turned into the direction
+///around its center. v1 and v2 are the front edge which rises on a slope.
+///The corners are taken from the forward and left vector, no rotation matrix is needed.
+void StaircaseBoundData::createStepTemplate(
+    int oneMeter,
+    FVector2D &direction,
+    std::vector<FVector> &output
+){
+    float half = oneMeter / 2.0f;
+    FVector2D forwardDir = direction.GetSafeNormal();
+    FVector forward(forwardDir.X * half, forwardDir.Y * half, 0);
+    FVector left(-forwardDir.Y * half, forwardDir.X * half, 0);
+    FVector center(half, half, 0);
+
+    output.clear();
+    output.push_back(center - forward - left); // v0
+    output.push_back(center + forward - left); // v1
+    output.push_back(center + forward + left); // v2
+    output.push_back(center - forward + left); // v3
+}
 
-    //important here: rotate around center of mass!
-    MMatrix rot = rotation();
-    for (int i = 0; i < quad.size(); i++){
-        quad[i] = rot * quad[i];
+///@brief moves the template of the stair to its position and height and appends it to the run,
+///updates the passed height offset
+void StaircaseBoundData::appendStep(
+    Stair &stair,
+    int oneMeter,
+    int rise,
+    FVector &heightOffset,
+    stepRun &run,
+    MeshData &outdata
+){
+    if(stair.isNone){ //skip if none
+        return;
+    }
+    if(stair.isFlat){
+        rise = 0;
     }
 
-    FVector fromCenter = toCenter * -1.0f;
-    MMatrix fromCenterMat(fromCenter);
-    for (int i = 0; i < quad.size(); i++){
-        quad[i] = fromCenterMat * quad[i];
+    std::vector<FVector> &profile = templateFor(oneMeter, stair.direction);
+    FVector offset(stair.posX * oneMeter, stair.posY * oneMeter, heightOffset.Z);
+    FVector up(0, 0, rise);
+
+    FVector v0 = profile[0] + offset;
+    FVector v1 = profile[1] + offset + up;
+    FVector v2 = profile[2] + offset + up;
+    FVector v3 = profile[3] + offset;
+    heightOffset.Z += rise;
+
+    //same direction and rise and connected to the front edge: same plane, extend
+    bool continuesRun = run.count > 0 &&
+        run.isFlat == stair.isFlat &&
+        run.rise == rise &&
+        run.direction.Equals(stair.direction) &&
+        run.quad[1].Equals(v0) &&
+        run.quad[2].Equals(v3);
+
+    if(continuesRun){
+        run.quad[1] = v1;
+        run.quad[2] = v2;
+        run.count++;
+        return;
     }
 
+    flushRun(run, outdata);
+    run.quad = {v0, v1, v2, v3};
+    run.direction = stair.direction;
+    run.isFlat = stair.isFlat;
+    run.rise = rise;
+    run.count = 1;
+}
 
-    //M = T * R <-- lese richtung --
-    FVector pos(posX * oneMeter, posY * oneMeter, 0);
-    MMatrix translateMat(pos);
-    for (int i = 0; i < quad.size(); i++){
-        quad[i] = translateMat * quad[i];
+void StaircaseBoundData::flushRun(stepRun &run, MeshData &outdata){
+    if(run.count <= 0){
+        return;
     }
-
-    return quad;
+    outdata.appendDoublesided(
+        run.quad[0],
+        run.quad[1],
+        run.quad[2],
+        run.quad[3]
+    );
+    quadCount++;
+    run.count = 0;
 }
 
-MMatrix StaircaseBoundData::Stair::rotation(){
-    FVector d3Vec(direction.X, direction.Y, 0);
-    return MMatrix::createRotatorFrom(d3Vec);
+int StaircaseBoundData::lastQuadCount(){
+    return quadCount;
 }
 
 
@@ -193,6 +223,8 @@ MeshData StaircaseBoundData::generate(int oneMeter, int heightMetersUpperLimit,
     //ACHTUNG: Berücksichtigt noch keine höhe! At all!
     MeshData outData;
     FVector maxHeightSave(0, 0, 0);
+    stepRun run;
+    quadCount = 0;
 
     //es muss korrekt an den kanten iteriert werden
     std::vector<TTouple<int, int>> indices;
@@ -216,9 +248,10 @@ MeshData StaircaseBoundData::generate(int oneMeter, int heightMetersUpperLimit,
                 maxSlopeMeters -= (nextSlope - heightMetersUpperLimit);
             }
 
-            current.appendData(oneMeter, maxSlopeMeters, outData, maxHeightSave);
+            appendStep(current, oneMeter, maxSlopeMeters, maxHeightSave, run, outData);
         }   
     }
+    flushRun(run, outData);
 
     outData.calculateNormals();
 
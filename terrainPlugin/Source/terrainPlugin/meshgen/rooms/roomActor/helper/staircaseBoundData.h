@@ -2,9 +2,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "CoreMath/Matrix/MMatrix.h"
 #include "GameCore/util/TTouple.h"
 #include "GameCore/MeshGenBase/MeshData/MeshData.h"
+#include <map>
+#include <vector>
 
 class TERRAINPLUGIN_API StaircaseBoundData{
 
@@ -16,6 +17,8 @@ public:
 
     MeshData generate(int oneMeter, int heightMeters, int maxSlopeMeters);
 
+    int lastQuadCount();
+
 private:
     void clearLayout(int sizeX, int sizeY);
 
@@ -56,19 +59,36 @@ private:
         bool isFlat = true;
 
         bool isNone = true;
+    };
 
-        void appendData(
-            int oneMeter, 
-            int slopeMeter, 
-            MeshData &outdata,
-            FVector &heightOffset
-        );
-
-        MMatrix rotation();
-
-        std::vector<FVector> orientedAndMovedQuad(int oneMeter);
+    /// @brief consecutive steps which lie in one plane, emitted as one quad
+    struct stepRun{
+        std::vector<FVector> quad;
+        FVector2D direction;
+        bool isFlat = true;
+        int rise = 0;
+        int count = 0;
     };
 
+    /// @brief step quad at the origin for each direction, built once per oneMeter.
+    /// Not static, staircases are built on the building worker threads.
+    std::map<int, std::vector<FVector>> stepTemplates;
+    int stepTemplatesOneMeter = 0;
+    int quadCount = 0;
+
+    std::vector<FVector> &templateFor(int oneMeter, FVector2D &direction);
+    static void createStepTemplate(int oneMeter, FVector2D &direction, std::vector<FVector> &output);
+
+    void appendStep(
+        Stair &stair,
+        int oneMeter,
+        int rise,
+        FVector &heightOffset,
+        stepRun &run,
+        MeshData &outdata
+    );
+    void flushRun(stepRun &run, MeshData &outdata);
+
     std::vector<std::vector<Stair>> layout;
 
     void getIndicesClockwise(
@@ -9,6 +9,7 @@
 #include "AssetPlugin/gamestart/assetManager.h"
 #include "GameCore/EntityGC/EntityManagerBase.h"
 #include "terrainPlugin/meshgen/rooms/roomActor/helper/staircaseBoundData.h"
+#include "terrainPlugin/meshgen/rooms/roomActor/helper/WallSlabBuilder.h"
 #include "GameCore/MeshGenBase/foliage/ETerrainType.h"
 #include "terrainPlugin/meshgen/rooms/doorLike/DoorBase.h"
 #include "terrainPlugin/meshgen/rooms/layoutCreator/layoutMaker.h"
@@ -46,29 +47,60 @@ void AroomProcedural::createRoom(
 ){
 	SetActorLocation(location);
 
-	/*
-	createRoom(
-		fullOffset,
+	int layers = FVectorUtil::randomNumber(1, 3);
+
+	//same layout was built before: only copy it
+	std::vector<materialEnum> materials = prefabMaterials();
+	std::vector<int> signature;
+	BuildingPrefabCache::signatureFor(
 		currentRoom,
 		oneMeter,
-		false, //open for stairs
-		true
-	);*/
+		layers,
+		materials,
+		locatedInTerrainType,
+		signature
+	);
+	BuildingPrefabCache *cache = BuildingPrefabCache::instance();
+	BuildingPrefabCache::prefab *found = cache->find(signature);
+	if(found == nullptr){
+		found = &cache->create(signature);
+		buildRoomPrefab(currentRoom, oneMeter, layers, *found);
+	}
 
-	//reset height because mesh starts at 0 height, world location is set by actor itself
-	location.Z = 0.0f;
-	int layers = FVectorUtil::randomNumber(1, 3);
-	for (int i = 0; i < layers; i++){
-		bool openForStaircaseBottom = (i != 0);
-		bool openForStaircaseTop = (i != layers - 1);
+	applyPrefab(*found);
+}
 
-		createRoom(
-			location,
-			currentRoom,
-			oneMeter,
-			openForStaircaseBottom,
-			openForStaircaseTop
-		);
+/// @brief material set of the room layers, part of the prefab key
+std::vector<materialEnum> AroomProcedural::prefabMaterials(){
+	return {
+		materialEnum::stoneMaterial,
+		materialEnum::wallMaterial,
+		materialEnum::glassMaterial
+	};
+}
+
+/// @brief copies the prefab layers into this actor, spawns its doors and uploads the mesh,
+/// nothing is built again. Game thread only.
+void AroomProcedural::applyPrefab(BuildingPrefabCache::prefab &prefab){
+	findMeshDataReference(materialEnum::stoneMaterial, ELod::lodNear, true) = prefab.floorAndRoof;
+	findMeshDataReference(materialEnum::wallMaterial, ELod::lodNear, true) = prefab.walls;
+	MeshData &glassLayer = findMeshDataReference(materialEnum::glassMaterial, ELod::lodNear, true);
+	glassLayer = prefab.windows;
+
+	TArray<FVector> &glassVertecies = glassLayer.getVerteciesRef();
+	for (int i = 0; i < prefab.paneRanges.size(); i++){
+		TTouple<int, int> &range = prefab.paneRanges[i];
+		glassPanes.addPane(range.first(), range.last(), glassVertecies);
+	}
+
+	FVector actorLocation = GetActorLocation();
+	for (int i = 0; i < prefab.doors.size(); i++){
+		BuildingPrefabCache::doorSpawn &spawn = prefab.doors[i];
+		FVector location = actorLocation + spawn.location;
+		ADoorBase *door = ADoorBase::Construct(GetWorld(), location);
+		if(door){
+			door->SetActorRotation(spawn.rotation);
+		}
 	}
 
 	//very important to reload the mesh
@@ -86,14 +118,44 @@ int AroomProcedural::zScaleInCentimeters(){
 }
 
 
+/// @brief builds all layers of a room as pure data, no actor or world is touched,
+/// safe to call from a worker thread (the room is modified, pass a copy)
+/// @param currentRoom room to build
+/// @param onemeter cm per index
+/// @param layers stacked layers, the upper ones get stairs
+/// @param output prefab to append to, actor space
+void AroomProcedural::buildRoomPrefab(
+	roomBoundData &currentRoom,
+	int onemeter,
+	int layers,
+	BuildingPrefabCache::prefab &output
+){
+	//mesh starts at 0 height, world location is set by actor itself
+	FVector location(0, 0, 0);
+	for (int i = 0; i < layers; i++){
+		bool openForStaircaseBottom = (i != 0);
+		bool openForStaircaseTop = (i != layers - 1);
+
+		buildRoomLayer(
+			location,
+			currentRoom,
+			onemeter,
+			openForStaircaseBottom,
+			openForStaircaseTop,
+			output
+		);
+	}
+}
+
 ///@brief creates the room and automatically adjusts @param location for the next layer, adds
 ///zcm to the vector! All meshes are transformed as expected in the next layer if calling the function again!
-void AroomProcedural::createRoom(
+void AroomProcedural::buildRoomLayer(
 	FVector &location, //bottom left corner, with heightOffset
 	roomBoundData &currentRoom,
 	int onemeter,
 	bool openForStaircaseBottom,
-	bool openForStaircaseTop
+	bool openForStaircaseTop,
+	BuildingPrefabCache::prefab &output
 ){
 
 	int scaleMetersX = currentRoom.xScale();
@@ -112,8 +174,7 @@ void AroomProcedural::createRoom(
 	MeshData floorAndRoof;
 	MeshData walls;
 	MeshData windows;
-
-	FVector bottomLeftAnchor;
+	std::vector<TTouple<int, int>> paneRanges;
 
 	currentRoom.appendBottomOrTopClosed(
 		floorAndRoof,
@@ -164,9 +225,8 @@ void AroomProcedural::createRoom(
 			windowPositions, 
 			doorWidthCm, 
 			zCm,
-			doorPositionsFilteredOut
-			//,
-			//location
+			doorPositionsFilteredOut,
+			paneRanges
 		);
 
 		FVector offset(0, 0, location.Z);
@@ -174,16 +234,14 @@ void AroomProcedural::createRoom(
 			doorPositionsFilteredOut,
 			from,
 			to,
-			doorWidthCm,
-			zCm,
-			offset
+			offset,
+			output.doors
 		);
 	}
 
 	//stairs debug
 	//DebugCreateStairs(floorAndRoof);
 
-	//testing from here needed to spawn the room / apply mesh(es)
 	floorAndRoof.calculateNormals();
 	walls.calculateNormals();
 
@@ -194,47 +252,22 @@ void AroomProcedural::createRoom(
 	walls.transformAllVertecies(translateOffset);
 	windows.transformAllVertecies(translateOffset);
 
+	//panes are shifted by the windows of the layers below
+	int glassVertexOffset = output.windows.verteciesNum();
+	for (int i = 0; i < paneRanges.size(); i++){
+		TTouple<int, int> &range = paneRanges[i];
+		output.paneRanges.push_back(TTouple<int, int>(glassVertexOffset + range.first(), range.last()));
+	}
 
-
-
-
-
-
-	/*
-	void appendMeshDataAndReload(
-		MeshData &meshdata,
-		materialEnum type,
-		ELod lodLevel,
-		bool raycastOnLayer
-	);
-	*/
-
-	bool raycastOnLayer = true;
-	appendMeshDataAndReload(
-		floorAndRoof,
-		materialEnum::stoneMaterial,
-		ELod::lodNear,
-		raycastOnLayer
-	);
-	appendMeshDataAndReload(
-		walls,
-		materialEnum::wallMaterial,
-		ELod::lodNear,
-		raycastOnLayer
-	);
-	appendMeshDataAndReload(
-		windows,
-		materialEnum::glassMaterial,
-		ELod::lodNear,
-		raycastOnLayer
-	);
-
-
+	output.floorAndRoof.append(floorAndRoof);
+	output.walls.append(walls);
+	output.windows.append(windows);
 
 	//go to next layer
 	location.Z += zCm;
 }
 
+
 void AroomProcedural::createWall(
 	MeshData &wallMesh,
 	MeshData &windowMesh,
@@ -244,7 +277,8 @@ void AroomProcedural::createWall(
 	std::vector<FVector> &windows, //windows in cm local
 	int doorWidthCm,
 	int scaleZCm,
-	std::vector<FVector> &doorPositionsFiltered
+	std::vector<FVector> &doorPositionsFiltered,
+	std::vector<TTouple<int, int>> &paneRanges
 ){
 	//sort vectors for consistent door placement, otherwise overlap issues occur
 	//very important!
@@ -256,10 +290,6 @@ void AroomProcedural::createWall(
 	}
 	
 
-	std::vector<FVector> oneDimWall;
-	oneDimWall.push_back(from); //FIRST WALL POSITION
-
-
 	//std::vector<FVector> doorsFiltered;
 	filterForVectorsBetween(
 		from,
@@ -278,24 +308,16 @@ void AroomProcedural::createWall(
 		windowsFiltered //output
 	);
 	
-	// create gaps for wall
-	createGapsFor(from, to, doorWidthCm, windowsFiltered, oneDimWall);
-	createGapsFor(from, to, doorWidthCm, doorPositionsFiltered, oneDimWall);
-	//last part added here, wall "complete", lower ceiling 
-	oneDimWall.push_back(to); //FINAL POSITION
-	sortVectorsBetween(from, to, oneDimWall);
-	
-
-	//walls new
-	//MeshData output;
-
+	//wall slab, doors and windows are cut out as full height openings
 	int widthCmWall = 20;
-	appendWallsFromMeshBounds(
-		wallMesh,
-		oneDimWall,
-		widthCmWall,
-		scaleZCm
-	);
+	WallSlabBuilder slab(from, to, widthCmWall, std::abs(scaleZCm));
+	for (int i = 0; i < windowsFiltered.size(); i++){
+		slab.addOpeningAt(windowsFiltered[i], doorWidthCm);
+	}
+	for (int i = 0; i < doorPositionsFiltered.size(); i++){
+		slab.addOpeningAt(doorPositionsFiltered[i], doorWidthCm);
+	}
+	slab.build(wallMesh);
 
 	// --- CREATE WINDOWS ---
 	
@@ -326,7 +348,8 @@ void AroomProcedural::createWall(
 	appendWindowsFromMeshBounds(
 		windowMesh,
 		oneDimWindows,
-		scaleZCm
+		scaleZCm,
+		paneRanges
 	);
 
 }
@@ -384,33 +407,12 @@ void AroomProcedural::createGapAt(
 }
 
 
-void AroomProcedural::appendWallsFromMeshBounds(
-	MeshData &output,
-	std::vector<FVector> &vec,
-	int widthCmWall,
-	int scaleZCm
-){
-	for (int i = 1; i < vec.size(); i += 2){ //immer one skip das die läcken der fenster auch da sind.
-		FVector &currentStart = vec[i - 1];
-		FVector &currentEnd = vec[i];
-
-		if(FVector::Dist(currentStart, currentEnd) > 10){
-			appendCubeTo(
-				output,
-				currentStart,
-				currentEnd,
-				std::abs(scaleZCm),
-				widthCmWall
-			);
-		}
-	}
-}
-
 //new helper method, merge windows into all meshdata from this actor
 void AroomProcedural::appendWindowsFromMeshBounds(
 	MeshData &output,
 	std::vector<FVector> &vec,
-	int scaleZCm
+	int scaleZCm,
+	std::vector<TTouple<int, int>> &paneRanges
 ){
 	FVector upVec(0, 0, std::abs(scaleZCm));
 	for (int i = 1; i < vec.size(); i += 2){ //immer one skip, paar weise
@@ -419,58 +421,12 @@ void AroomProcedural::appendWindowsFromMeshBounds(
 		FVector v1 = v0 + upVec;
 		FVector v2 = v3 + upVec;
 
+		int vertexStart = output.verteciesNum();
 		output.appendDoublesided(v0, v1, v2, v3);
+		paneRanges.push_back(TTouple<int, int>(vertexStart, output.verteciesNum() - vertexStart));
 	}
 }
 
-
-
-
-
-
-
-
-void AroomProcedural::appendCubeTo(
-	MeshData &outputData,
-	FVector &start,
-	FVector &end,
-	float height,
-	float width
-){
-	FVector offsetZ(0, 0, height);
-	FVector offsetWidth(width, 0, 0); //x is forward in MMatrix, create rotator from start to end
-
-	FVector start2D = start;
-	start2D.Z = 0.0f;
-	FVector end2D = end;
-	end2D.Z = 0.0f;
-	FVector connect = end2D - start2D;
-
-	MMatrix rotator = MMatrix::createRotatorFrom(connect);
-	rotator.yawRadAdd(MMatrix::degToRadian(90.0f));
-
-	offsetWidth = rotator * offsetWidth; //eindrehen
-
-	/*
-	1->2
-	0<-3
-	*/
-	FVector a = start;
-	FVector b = end;
-	FVector c = end + offsetWidth;
-	FVector d = start + offsetWidth;
-
-	FVector a1 = a + offsetZ;
-	FVector b1 = b + offsetZ;
-	FVector c1 = c + offsetZ;
-	FVector d1 = d + offsetZ;
-
-
-	outputData.appendCube(a, b, c, d, a1, b1, c1, d1);
-
-}
-
-
 //deprecated.
 
 /// @brief creates a new mesh from touples representing the vertical edges of an window
@@ -581,13 +537,18 @@ void AroomProcedural::removeCloseTouples(
 
 
 
+/// @brief records the doors of a wall, they are spawned with the prefab
+/// @param doorPositions door positions in cm local
+/// @param start wall start
+/// @param end wall end
+/// @param offset layer offset
+/// @param output door spawns in actor space
 void AroomProcedural::createDoorsAt(
 	std::vector<FVector> &doorPositions,
 	FVector &start,
 	FVector &end,
-	int width,
-	int height,
-	FVector &offset
+	FVector &offset,
+	std::vector<BuildingPrefabCache::doorSpawn> &output
 ){
 	FVector dir = end - start;
 	dir.Z = 0.0f;
@@ -598,34 +559,13 @@ void AroomProcedural::createDoorsAt(
 	rotation.Yaw += 90.0f;
 
 	for (int i = 0; i < doorPositions.size(); i++){
-		FVector currentPos = doorPositions[i];
-		currentPos += GetActorLocation();
-		currentPos += offset;
-
-		//erstmal so
-		ADoorBase *door = ADoorBase::Construct(
-			GetWorld(),
-			currentPos
-		);
-
-		if(door){
-			door->SetActorRotation(rotation);
-		}
+		BuildingPrefabCache::doorSpawn spawn;
+		spawn.location = doorPositions[i] + offset;
+		spawn.rotation = rotation;
+		output.push_back(spawn);
 	}
 }
 
-
-void AroomProcedural::createDoorsAt(
-	std::vector<FVector> &doorPositions,
-	FVector &start,
-	FVector &end,
-	int width,
-	int height
-){
-	FVector offset(0, 0, 0);
-	createDoorsAt(doorPositions, start, end, width, height, offset);
-}
-
 /// @brief will filter positions from the positions to filter vector
 /// and add the positions which meet the requirement into the filtered list
 /// @param A start
@@ -687,38 +627,6 @@ float AroomProcedural::lenghtOf(FVector &vec){
 }
 
 
-void AroomProcedural::sortVectorsBetween(FVector &A, FVector &B, std::vector<FVector> &output){
-	FVector AB = B - A;
-
-	bool vectorIsXDirection = AB.X != 0; //ansonsten Z
-	bool isNegativeToPositive = true;
-	if(vectorIsXDirection){
-		isNegativeToPositive = AB.X > 0; //from 0 to 8 for example direction
-	}else{
-		isNegativeToPositive = AB.Y > 0; //from 0 to 8 for example direction
-	}
-
-
-	std::sort(
-		output.begin(), output.end(),
-		[vectorIsXDirection, isNegativeToPositive]
-		(const FVector &a, const FVector &b) {
-		if(vectorIsXDirection){
-			return a.X < b.X;
-		}else{
-			return a.Y < b.Y;
-		}
-	});
-
-	//debug print sorted vector
-	DebugHelper::logMessage("debug vector sorted: ");
-	for (int i = 0; i < output.size(); i++)
-	{
-		int number = vectorIsXDirection ? output.at(i).X : output.at(i).Y;
-		FString s = FString::Printf(TEXT("debug vector sorted %d"), number);
-		DebugHelper::logMessage(s); // sieht gut aus
-	}
-}
 
 
 
@@ -757,7 +665,7 @@ void AroomProcedural::spawnRooms(
 		roomBoundData &currentRoom = vec.at(i);
 		//create proper offset in xpos and ypos as needed
 
-		int onemeter = 100;
+		int onemeter = ONE_METER;
 
 		FVector fullOffset = location + currentRoom.positionInMeterSpace(onemeter);
 		AroomProcedural *newRoom = spawnRoom(worldIn, fullOffset);
@@ -776,6 +684,37 @@ void AroomProcedural::spawnRooms(
 	}
 }
 
+/// @brief game thread part of the building pipeline, spawns rooms which were already
+/// built off thread, only the prefab is copied and uploaded
+/// @param world world to spawn in
+/// @param location location of the building
+/// @param rooms rooms of the layout
+/// @param prefabs built prefab for each room, same order, rooms with the same layout share one
+void AroomProcedural::spawnRoomsFromPrefabs(
+	UWorld *world,
+	FVector location,
+	std::vector<roomBoundData> &rooms,
+	std::vector<BuildingPrefabCache::prefab *> &prefabs,
+	ETerrainType terraintype
+){
+	if(world == nullptr){
+		return;
+	}
+
+	int count = std::min(rooms.size(), prefabs.size());
+	for (int i = 0; i < count; i++){
+		if(prefabs[i] == nullptr){
+			continue;
+		}
+		FVector fullOffset = location + rooms[i].positionInMeterSpace(ONE_METER);
+		AroomProcedural *newRoom = spawnRoom(world, fullOffset);
+		if(newRoom != nullptr){
+			newRoom->updateTerrainTypeLocatedIn(terraintype);
+			newRoom->applyPrefab(*prefabs[i]);
+		}
+	}
+}
+
 void AroomProcedural::updateTerrainTypeLocatedIn(ETerrainType input){
 	locatedInTerrainType = input;
 }
@@ -7,6 +7,7 @@
 #include "GameFramework/Actor.h"
 #include "GameCore/util/TTouple.h"
 #include "terrainPlugin/meshgen/rooms/roomActor/roomBoundData.h"
+#include "terrainPlugin/meshgen/rooms/roomActor/helper/BuildingPrefabCache.h"
 #include "GameCore/MeshGenBase/foliage/ETerrainType.h"
 #include "roomProcedural.generated.h"
 
@@ -36,6 +37,25 @@ public:
 		ETerrainType terraintype
 	);
 
+	static void buildRoomPrefab(
+		roomBoundData &currentRoom,
+		int onemeter,
+		int layers,
+		BuildingPrefabCache::prefab &output
+	);
+
+	static void spawnRoomsFromPrefabs(
+		UWorld *world,
+		FVector location,
+		std::vector<roomBoundData> &rooms,
+		std::vector<BuildingPrefabCache::prefab *> &prefabs,
+		ETerrainType terraintype
+	);
+
+	static std::vector<materialEnum> prefabMaterials();
+
+	static const int ONE_METER = 100;
+
 private:
 	ETerrainType locatedInTerrainType;
 
@@ -43,9 +63,9 @@ private:
 
 	void updateTerrainTypeLocatedIn(ETerrainType input);
 
-	int zScaleInCentimeters();
+	static int zScaleInCentimeters();
 
-	void createWall(
+	static void createWall(
 		MeshData &wallMesh,
 		MeshData &windowMesh,
 		FVector from,
@@ -54,12 +74,13 @@ private:
 		std::vector<FVector> &windows, // windows in cm local
 		int doorWidthCm,
 		int scaleZCm,
-		std::vector<FVector> &doorPositionsFilteredOut
+		std::vector<FVector> &doorPositionsFilteredOut,
+		std::vector<TTouple<int, int>> &paneRanges
 	);
 
 
 
-	void filterForVectorsBetween(
+	static void filterForVectorsBetween(
 		FVector &A,
 		FVector &B,
 		int minDistance,
@@ -67,11 +88,9 @@ private:
 		std::vector<FVector> &output
 	);
 
-	void sortVectorsBetween(FVector &a, FVector &b, std::vector<FVector> &vec);
+	static float lenghtOf(FVector &vec);
 
-	float lenghtOf(FVector &vec);
-
-	void removeCloseTouples(
+	static void removeCloseTouples(
 		std::vector<FVector> &vec
 	);
 
@@ -83,7 +102,7 @@ private:
 		FVector &offset
 	);
 
-	void createGapsFor(
+	static void createGapsFor(
 		FVector &start,
 		FVector &end,
 		float width,
@@ -91,7 +110,7 @@ private:
 		std::vector<FVector> &output
 	);
 
-	void createGapAt(
+	static void createGapAt(
 		FVector &start,
 		FVector &end,
 		FVector &locationStart,
@@ -99,44 +118,23 @@ private:
 		std::vector<FVector> &output
 	);
 
-	void createDoorsAt(
+	static void createDoorsAt(
 		std::vector<FVector> &doorPositions,
 		FVector &start,
 		FVector &end,
-		int width,
-		int height
+		FVector &offset,
+		std::vector<BuildingPrefabCache::doorSpawn> &output
 	);
 
-	void createDoorsAt(
-		std::vector<FVector> &doorPositions,
-		FVector &start,
-		FVector &end,
-		int width,
-		int height,
-		FVector &offset
-	);
-
-	void appendWallsFromMeshBounds(
+	//new testing, paneRanges: vertex start and count of each pane in output
+	static void appendWindowsFromMeshBounds(
 		MeshData &output,
 		std::vector<FVector> &vec,
-		int widthCmWall,
-		int scaleZCm
-	);
-
-	//new testing
-	void appendWindowsFromMeshBounds(
-		MeshData &output,
-		std::vector<FVector> &vec,
-		int scaleZCm
+		int scaleZCm,
+		std::vector<TTouple<int, int>> &paneRanges
 	);
 
-	void appendCubeTo(
-		MeshData &outputData,
-		FVector &start,
-		FVector &end,
-		float height,
-		float width
-	);
+	void applyPrefab(BuildingPrefabCache::prefab &prefab);
 
 	void createRoom(
 		FVector location,
@@ -144,12 +142,13 @@ private:
 		int oneMeter
 	);
 
-	void createRoom(
+	static void buildRoomLayer(
 		FVector &location, //bottom left corner
 		roomBoundData &currentRoom,
 		int onemeter,
 		bool openForStaircaseBottom,
-		bool openForStaircaseTop
+		bool openForStaircaseTop,
+		BuildingPrefabCache::prefab &output
 	);
 
 	static AroomProcedural *spawnRoom(UWorld *world, FVector location);
@@ -165,7 +164,7 @@ private:
 
 	void DebugCreateStairs(MeshData &appendTo);
 
-	void createStairs(
+	static void createStairs(
 		MeshData &data,
 		roomBoundData &room,
 		int oneMeter);
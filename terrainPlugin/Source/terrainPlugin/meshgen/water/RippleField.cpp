@@ -0,0 +1,197 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RippleField.h"
+#include <algorithm>
+#include <cmath>
+
+RippleField::RippleField()
+{
+    //all slots exist from the start, adding never allocates
+    FVector zero(0, 0, 0);
+    pool.reserve(MAX_RIPPLES);
+    for (int i = 0; i < MAX_RIPPLES; i++){
+        pool.push_back(ripple(zero, 0.0f));
+    }
+    activeCount = 0;
+}
+
+RippleField::~RippleField()
+{
+}
+
+bool RippleField::hasRipples(){
+    return activeCount > 0;
+}
+
+int RippleField::num(){
+    return activeCount;
+}
+
+/// @brief starts a new ripple, if the pool is full the most faded ripple is replaced
+/// @param impactPoint impact in world space
+/// @param maxRadius radius at which the ripple is retired
+void RippleField::add(FVector &impactPoint, float maxRadius){
+    if(activeCount < MAX_RIPPLES){
+        pool[activeCount].init(impactPoint, maxRadius);
+        activeCount++;
+        return;
+    }
+
+    int weakest = 0;
+    for (int i = 1; i < activeCount; i++){
+        if(pool[i].waveHeightBasedOnTime() < pool[weakest].waveHeightBasedOnTime()){
+            weakest = i;
+        }
+    }
+    pool[weakest].init(impactPoint, maxRadius);
+}
+
+/// @brief ticks all active ripples, expired or faded ripples are retired right away
+void RippleField::tick(float deltaTime){
+    int i = 0;
+    while(i < activeCount){
+        ripple &current = pool[i];
+        current.Tick(deltaTime);
+        if(current.timeExceeded() || current.waveHeightBasedOnTime() < MIN_VISIBLE_HEIGHT){
+            retireAt(i); //last one is swapped in, check same index again
+        }else{
+            i++;
+        }
+    }
+}
+
+/// @brief O(1) removal, the last active ripple takes the slot
+void RippleField::retireAt(int index){
+    if(index < 0 || index >= activeCount){
+        return;
+    }
+    int last = activeCount - 1;
+    if(index != last){
+        std::swap(pool[index], pool[last]);
+    }
+    activeCount--;
+}
+
+/// @brief adds the ripple heights to the vertecies, expects the pane grid layout
+/// (quadsPerAxis + 1)^2 vertecies, x major, vertex (x, y) at (x * detail, y * detail)
+/// @param vertecies local vertecies of the pane, waves already applied
+/// @param quadsPerAxis quads on one axis
+/// @param detail distance between vertecies in cm
+/// @param actorLocation pane location to move the impacts to local space
+void RippleField::apply(
+    TArray<FVector> &vertecies,
+    int quadsPerAxis,
+    int detail,
+    FVector &actorLocation
+){
+    FVector gridOffset(0, 0, 0);
+    apply(vertecies, quadsPerAxis, detail, actorLocation, gridOffset);
+}
+
+/// @brief same as apply, the grid starts at gridOffset in local space, the first
+/// (quadsPerAxis + 1)^2 vertecies must be the grid
+/// @param gridOffset local position of grid vertex (0, 0)
+void RippleField::apply(
+    TArray<FVector> &vertecies,
+    int quadsPerAxis,
+    int detail,
+    FVector &actorLocation,
+    FVector &gridOffset
+){
+    int verteciesPerAxis = quadsPerAxis + 1;
+    if(activeCount <= 0 || detail <= 0 || vertecies.Num() < verteciesPerAxis * verteciesPerAxis){
+        return;
+    }
+
+    for (int i = 0; i < activeCount; i++){
+        applyRipple(pool[i], vertecies, quadsPerAxis, detail, actorLocation, gridOffset, nullptr);
+    }
+}
+
+/// @brief same as apply for a grid which is not stored as a full block, for example
+/// a ring with a hole
+/// @param indexMap grid index x * (quadsPerAxis + 1) + y to vertex index, -1 if the
+/// grid vertex does not exist
+void RippleField::apply(
+    TArray<FVector> &vertecies,
+    int quadsPerAxis,
+    int detail,
+    FVector &actorLocation,
+    FVector &gridOffset,
+    std::vector<int> &indexMap
+){
+    int verteciesPerAxis = quadsPerAxis + 1;
+    if(activeCount <= 0 || detail <= 0 || indexMap.size() < verteciesPerAxis * verteciesPerAxis){
+        return;
+    }
+
+    for (int i = 0; i < activeCount; i++){
+        applyRipple(pool[i], vertecies, quadsPerAxis, detail, actorLocation, gridOffset, &indexMap);
+    }
+}
+
+/// @brief visits only the vertecies between the inner and outer circle of the ring,
+/// the distance is measured on the water plane
+/// @param indexMap grid to vertex index or nullptr if the grid is stored as full block
+void RippleField::applyRipple(
+    ripple &current,
+    TArray<FVector> &vertecies,
+    int quadsPerAxis,
+    int detail,
+    FVector &actorLocation,
+    FVector &gridOffset,
+    std::vector<int> *indexMap
+){
+    int verteciesPerAxis = quadsPerAxis + 1;
+    int lastIndex = quadsPerAxis;
+
+    FVector center = current.impactPoint() - actorLocation;
+    FVector centerInGrid = center - gridOffset;
+    float outer = current.currentRadius() + current.influenceWidth();
+    float inner = current.currentRadius() - current.influenceWidth();
+
+    int minX = std::max(0, (int)std::floor((centerInGrid.X - outer) / detail));
+    int maxX = std::min(lastIndex, (int)std::ceil((centerInGrid.X + outer) / detail));
+
+    for (int x = minX; x <= maxX; x++){
+        float dx = x * detail - centerInGrid.X;
+        float outerSquared = outer * outer - dx * dx;
+        if(outerSquared < 0.0f){
+            continue;
+        }
+        float outerHalf = std::sqrt(outerSquared);
+        int minY = std::max(0, (int)std::floor((centerInGrid.Y - outerHalf) / detail));
+        int maxY = std::min(lastIndex, (int)std::ceil((centerInGrid.Y + outerHalf) / detail));
+
+        //vertecies strictly inside the inner circle are not touched by the ring
+        int skipFrom = maxY + 1;
+        int skipTo = maxY;
+        if(inner > 0.0f){
+            float innerSquared = inner * inner - dx * dx;
+            if(innerSquared > 0.0f){
+                float innerHalf = std::sqrt(innerSquared);
+                skipFrom = (int)std::floor((centerInGrid.Y - innerHalf) / detail) + 1;
+                skipTo = (int)std::ceil((centerInGrid.Y + innerHalf) / detail) - 1;
+            }
+        }
+
+        int rowOffset = x * verteciesPerAxis;
+        for (int y = minY; y <= maxY; y++){
+            if(y >= skipFrom && y <= skipTo){
+                y = skipTo;
+                continue;
+            }
+            int index = rowOffset + y;
+            if(indexMap != nullptr){
+                index = (*indexMap)[index];
+                if(index < 0 || index >= vertecies.Num()){
+                    continue;
+                }
+            }
+            FVector &vertex = vertecies[index];
+            float toCenter = FVector::Dist2D(vertex, center);
+            vertex.Z += current.heightOffsetAt(toCenter);
+        }
+    }
+}
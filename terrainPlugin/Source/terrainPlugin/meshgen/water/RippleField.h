@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ripple.h"
+#include <vector>
+
+/**
+ * fixed size pool of ripples for one water pane.
+ * The pool is filled once in the constructor, adding a ripple reuses a slot and an
+ * expired or faded ripple is retired in O(1) by swapping it with the last active one.
+ * Applying the ripples only visits the grid vertecies inside each ripples moving ring
+ * (radius +- width), row by row on the pane grid, instead of every vertex per ripple.
+ */
+class TERRAINPLUGIN_API RippleField
+{
+public:
+	RippleField();
+	~RippleField();
+
+	static const int MAX_RIPPLES = 16;
+
+	void add(FVector &impactPoint, float maxRadius);
+	void tick(float deltaTime);
+
+	bool hasRipples();
+	int num();
+
+	void apply(
+		TArray<FVector> &vertecies,
+		int quadsPerAxis,
+		int detail,
+		FVector &actorLocation
+	);
+	void apply(
+		TArray<FVector> &vertecies,
+		int quadsPerAxis,
+		int detail,
+		FVector &actorLocation,
+		FVector &gridOffset
+	);
+	void apply(
+		TArray<FVector> &vertecies,
+		int quadsPerAxis,
+		int detail,
+		FVector &actorLocation,
+		FVector &gridOffset,
+		std::vector<int> &indexMap
+	);
+
+private:
+	/// below this height in cm a ripple is not visible anymore and retired
+	static constexpr float MIN_VISIBLE_HEIGHT = 0.5f;
+
+	std::vector<ripple> pool;
+	int activeCount = 0;
+
+	void retireAt(int index);
+
+	void applyRipple(
+		ripple &current,
+		TArray<FVector> &vertecies,
+		int quadsPerAxis,
+		int detail,
+		FVector &actorLocation,
+		FVector &gridOffset,
+		std::vector<int> *indexMap
+	);
+};
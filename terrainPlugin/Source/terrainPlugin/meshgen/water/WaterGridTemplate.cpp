@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WaterGridTemplate.h"
+
+WaterGridTemplate *WaterGridTemplate::instancePointer = nullptr;
+
+void WaterGridTemplate::EndGame(){
+    if(WaterGridTemplate *ptr = instancePointer){
+        delete ptr;
+        WaterGridTemplate::instancePointer = nullptr;
+    }
+}
+
+/// @brief you are not allowed to delete this pointer!
+/// @return instance pointer
+WaterGridTemplate *WaterGridTemplate::instance(){
+    if(WaterGridTemplate::instancePointer == nullptr){
+        WaterGridTemplate::instancePointer = new WaterGridTemplate();
+    }
+    return WaterGridTemplate::instancePointer;
+}
+
+WaterGridTemplate::WaterGridTemplate()
+{
+}
+
+WaterGridTemplate::~WaterGridTemplate()
+{
+    gridMap.clear();
+}
+
+/// @brief returns the shared grid, builds it on first request
+/// @param quadCountPerAxis quads on x and y
+/// @param detail distance between vertecies in cm
+/// @return grid mesh data, do not modify, copy it
+MeshData &WaterGridTemplate::gridFor(int quadCountPerAxis, int detail){
+    std::pair<int, int> key(quadCountPerAxis, detail);
+    auto it = gridMap.find(key);
+    if(it != gridMap.end()){
+        return it->second;
+    }
+
+    MeshData &grid = gridMap[key];
+    buildGrid(quadCountPerAxis, detail, grid);
+    return grid;
+}
+
+/// @brief index of a grid vertex, x major like the old pane loop
+int WaterGridTemplate::vertexIndex(int x, int y, int quadCountPerAxis){
+    return x * (quadCountPerAxis + 1) + y;
+}
+
+/// @brief writes a flat grid with its pivot at the bottom left corner
+/// same winding as appendEfficent(v0, v1, v2, v3) of the old pane loop
+/// @param quadCountPerAxis quads on x and y
+/// @param detail distance between vertecies in cm
+/// @param output mesh data to override
+void WaterGridTemplate::buildGrid(int quadCountPerAxis, int detail, MeshData &output){
+    if(quadCountPerAxis < 1){
+        quadCountPerAxis = 1;
+    }
+    int verteciesPerAxis = quadCountPerAxis + 1;
+
+    TArray<FVector> vertecies;
+    vertecies.Reserve(verteciesPerAxis * verteciesPerAxis);
+    for (int x = 0; x < verteciesPerAxis; x++){
+        for (int y = 0; y < verteciesPerAxis; y++){
+            vertecies.Add(FVector(x * detail, y * detail, 0));
+        }
+    }
+
+    TArray<int32> triangles;
+    triangles.Reserve(quadCountPerAxis * quadCountPerAxis * 6);
+    for (int x = 0; x < quadCountPerAxis; x++){
+        for (int y = 0; y < quadCountPerAxis; y++){
+            /*
+            1 2
+            0 3
+            */
+            int v0 = vertexIndex(x, y, quadCountPerAxis);
+            int v1 = vertexIndex(x, y + 1, quadCountPerAxis);
+            int v2 = vertexIndex(x + 1, y + 1, quadCountPerAxis);
+            int v3 = vertexIndex(x + 1, y, quadCountPerAxis);
+
+            triangles.Add(v0);
+            triangles.Add(v1);
+            triangles.Add(v2);
+
+            triangles.Add(v0);
+            triangles.Add(v2);
+            triangles.Add(v3);
+        }
+    }
+
+    output.rebuild(MoveTemp(vertecies), MoveTemp(triangles));
+}
@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameCore/MeshGenBase/MeshData/MeshData.h"
+#include <map>
+#include <utility>
+
+/**
+ * canonical flat water grid, built once per (quad count, detail) and shared by all
+ * water panes. The grid is written directly as (n+1)^2 vertecies and a fixed index
+ * pattern, no vertex welding. A pane only copies the buffers, its own offset is the
+ * actor transform.
+ */
+class TERRAINPLUGIN_API WaterGridTemplate
+{
+public:
+	static WaterGridTemplate *instance();
+	static void EndGame();
+	~WaterGridTemplate();
+
+	MeshData &gridFor(int quadCountPerAxis, int detail);
+
+	static void buildGrid(int quadCountPerAxis, int detail, MeshData &output);
+
+	static int vertexIndex(int x, int y, int quadCountPerAxis);
+
+private:
+	WaterGridTemplate();
+	static class WaterGridTemplate *instancePointer;
+
+	std::map<std::pair<int, int>, MeshData> gridMap;
+};
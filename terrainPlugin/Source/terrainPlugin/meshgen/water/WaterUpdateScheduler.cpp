@@ -0,0 +1,211 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WaterUpdateScheduler.h"
+#include "CoreGlobals.h"
+#include "HAL/PlatformTime.h"
+#include "GameCore/DebugHelper.h"
+#include "GameCore/PlayerInfo/PlayerInfo.h"
+#include <algorithm>
+
+WaterUpdateScheduler *WaterUpdateScheduler::instancePointer = nullptr;
+
+void WaterUpdateScheduler::EndGame(){
+    if(WaterUpdateScheduler *ptr = instancePointer){
+        delete ptr;
+        WaterUpdateScheduler::instancePointer = nullptr;
+    }
+}
+
+/// @brief you are not allowed to delete this pointer!
+/// @return instance pointer
+WaterUpdateScheduler *WaterUpdateScheduler::instance(){
+    if(WaterUpdateScheduler::instancePointer == nullptr){
+        WaterUpdateScheduler::instancePointer = new WaterUpdateScheduler();
+    }
+    return WaterUpdateScheduler::instancePointer;
+}
+
+WaterUpdateScheduler::WaterUpdateScheduler()
+{
+    reportStart = FPlatformTime::Seconds();
+}
+
+WaterUpdateScheduler::~WaterUpdateScheduler()
+{
+    panes.clear();
+    candidates.clear();
+}
+
+/// @brief adds a pane, ids are not reused
+/// @return id to report and query the pane with
+int WaterUpdateScheduler::registerPane(){
+    int id = nextPaneId;
+    nextPaneId++;
+    panes[id] = PaneState();
+    return id;
+}
+
+void WaterUpdateScheduler::unregisterPane(int pane){
+    panes.erase(pane);
+}
+
+/// @brief max pane refreshes per frame
+void WaterUpdateScheduler::setBudget(int count){
+    updatesPerFrame = std::max(1, count);
+}
+
+int WaterUpdateScheduler::budget(){
+    return updatesPerFrame;
+}
+
+/// @brief pane reports its state each tick, used for the next plan
+/// @param pane pane id
+/// @param location pane location
+/// @param visible pane is in render range
+/// @param ripplesActive pane has active ripples
+/// @param waveTime time the waves would be shaded with
+void WaterUpdateScheduler::reportPane(
+    int pane,
+    FVector &location,
+    bool visible,
+    bool ripplesActive,
+    float waveTime
+){
+    auto it = panes.find(pane);
+    if(it == panes.end()){
+        return;
+    }
+    PaneState &state = it->second;
+    state.location = location;
+    state.visible = visible;
+    state.ripplesActive = ripplesActive;
+    state.waveTime = waveTime;
+}
+
+/// @brief returns if the pane should run its vertex shader this frame,
+/// the first call of a frame plans the whole frame
+bool WaterUpdateScheduler::shouldUpdate(int pane){
+    if(!planned || plannedFrame != GFrameCounter){
+        planFrame();
+    }
+    auto it = panes.find(pane);
+    if(it == panes.end()){
+        return true; //not registered, not limited
+    }
+    return it->second.scheduled;
+}
+
+/// @brief pane did refresh, saves the shaded state
+void WaterUpdateScheduler::markUpdated(int pane){
+    auto it = panes.find(pane);
+    if(it == panes.end()){
+        return;
+    }
+    PaneState &state = it->second;
+    state.lastUpdateFrame = GFrameCounter;
+    state.lastWaveTime = state.waveTime;
+    state.hadRipples = state.ripplesActive;
+    state.scheduled = false;
+    bandUpdates[state.band]++;
+}
+
+int WaterUpdateScheduler::bandFor(float distance){
+    for (int i = 0; i < BAND_COUNT - 1; i++){
+        if(distance < BAND_DISTANCE[i]){
+            return i;
+        }
+    }
+    return BAND_COUNT - 1;
+}
+
+/// @brief ripples always change the surface, the last refresh with ripples must be
+/// followed by one without to remove them, waves only after a visible time step
+bool WaterUpdateScheduler::hasVisibleChange(PaneState &state){
+    if(state.ripplesActive || state.hadRipples){
+        return true;
+    }
+    return std::abs(state.waveTime - state.lastWaveTime) >= MIN_WAVE_TIME_STEP;
+}
+
+/// @brief selects the most overdue visible panes up to the budget
+void WaterUpdateScheduler::planFrame(){
+    plannedFrame = GFrameCounter;
+    planned = true;
+    framesInReport++;
+
+    FVector playerLocation = PlayerInfo::playerLocation();
+
+    candidates.clear();
+    for (auto &entry : panes){
+        PaneState &state = entry.second;
+        state.scheduled = false;
+        if(!state.visible){
+            continue;
+        }
+
+        state.band = bandFor(FVector::Dist2D(state.location, playerLocation));
+        bandPaneFrames[state.band]++;
+
+        uint64 interval = BAND_INTERVAL[state.band];
+        uint64 framesSince = plannedFrame - state.lastUpdateFrame;
+        if(framesSince < interval || !hasVisibleChange(state)){
+            continue;
+        }
+        float overdue = (float)framesSince / interval;
+        candidates.push_back(std::pair<float, PaneState *>(overdue, &state));
+    }
+
+    int count = std::min((int)candidates.size(), updatesPerFrame);
+    std::partial_sort(
+        candidates.begin(),
+        candidates.begin() + count,
+        candidates.end(),
+        [](const std::pair<float, PaneState *> &a, const std::pair<float, PaneState *> &b){
+            return a.first > b.first;
+        }
+    );
+    for (int i = 0; i < count; i++){
+        candidates[i].second->scheduled = true;
+    }
+
+    updateReport();
+}
+
+/// @brief refreshes per second and pane of a band, measured over the last report window
+float WaterUpdateScheduler::updateRateForBand(int band){
+    if(band < 0 || band >= BAND_COUNT){
+        return 0.0f;
+    }
+    return bandRates[band];
+}
+
+void WaterUpdateScheduler::updateReport(){
+    double now = FPlatformTime::Seconds();
+    double elapsed = now - reportStart;
+    if(elapsed < REPORT_SECONDS || framesInReport <= 0){
+        return;
+    }
+
+    for (int i = 0; i < BAND_COUNT; i++){
+        float averagePanes = (float)bandPaneFrames[i] / framesInReport;
+        bandRates[i] = averagePanes > 0.0f ? (bandUpdates[i] / averagePanes) / elapsed : 0.0f;
+    }
+
+    FString message = FString::Printf(
+        TEXT("WaterUpdateScheduler refresh rate per pane (Hz): near %.1f, mid %.1f, far %.1f, budget %d, fps %.1f"),
+        bandRates[0],
+        bandRates[1],
+        bandRates[2],
+        updatesPerFrame,
+        framesInReport / elapsed
+    );
+    DebugHelper::logMessage(message);
+
+    reportStart = now;
+    framesInReport = 0;
+    for (int i = 0; i < BAND_COUNT; i++){
+        bandUpdates[i] = 0;
+        bandPaneFrames[i] = 0;
+    }
+}
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <map>
+#include <vector>
+
+/**
+ * global scheduler for the cpu water shader of all panes.
+ * A pane is anything refreshed as one unit, a water actor or one level of the clipmap,
+ * it is identified by the id returned from registerPane.
+ * Once per frame the visible panes are sorted into distance bands, near panes are due
+ * every frame, far panes every few frames. From the due panes only the most overdue ones
+ * up to the frame budget refresh, panes without ripples and without a visible wave
+ * phase step since their last refresh are skipped.
+ * The achieved refresh rate per band is logged every REPORT_SECONDS.
+ */
+class TERRAINPLUGIN_API WaterUpdateScheduler
+{
+public:
+	static WaterUpdateScheduler *instance();
+	static void EndGame();
+	~WaterUpdateScheduler();
+
+	static const int BAND_COUNT = 3;
+	static const int DEFAULT_BUDGET = 8;
+	static constexpr float REPORT_SECONDS = 5.0f;
+
+	int registerPane();
+	void unregisterPane(int pane);
+
+	void reportPane(
+		int pane,
+		FVector &location,
+		bool visible,
+		bool ripplesActive,
+		float waveTime
+	);
+	bool shouldUpdate(int pane);
+	void markUpdated(int pane);
+
+	void setBudget(int count);
+	int budget();
+
+	float updateRateForBand(int band);
+
+private:
+	WaterUpdateScheduler();
+	static class WaterUpdateScheduler *instancePointer;
+
+	/// upper distance of the bands in cm, last band is open
+	static constexpr float BAND_DISTANCE[BAND_COUNT - 1] = {2000.0f, 5000.0f};
+	/// refresh every n frames per band
+	static constexpr int BAND_INTERVAL[BAND_COUNT] = {1, 2, 4};
+	/// wave time step below which a pane without ripples is not refreshed
+	static constexpr float MIN_WAVE_TIME_STEP = 1.0f / 30.0f;
+
+	struct PaneState{
+		FVector location = FVector(0, 0, 0);
+		bool visible = false;
+		bool ripplesActive = false;
+		bool hadRipples = false;
+		float waveTime = 0.0f;
+		float lastWaveTime = -1.0f;
+		uint64 lastUpdateFrame = 0;
+		int band = 0;
+		bool scheduled = false;
+	};
+	std::map<int, PaneState> panes;
+	int nextPaneId = 0;
+
+	int updatesPerFrame = DEFAULT_BUDGET;
+	uint64 plannedFrame = 0;
+	bool planned = false;
+
+	std::vector<std::pair<float, PaneState *>> candidates;
+
+	void planFrame();
+	int bandFor(float distance);
+	bool hasVisibleChange(PaneState &state);
+
+	//statistics
+	double reportStart = 0.0;
+	int framesInReport = 0;
+	int bandUpdates[BAND_COUNT] = {0, 0, 0};
+	int bandPaneFrames[BAND_COUNT] = {0, 0, 0};
+	float bandRates[BAND_COUNT] = {0.0f, 0.0f, 0.0f};
+	void updateReport();
+};
@@ -0,0 +1,688 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "clipmapWaterActor.h"
+#include "GameCore/PlayerInfo/PlayerInfo.h"
+#include "terrainPlugin/meshgen/water/WaterUpdateScheduler.h"
+#include <cmath>
+#include <algorithm>
+
+
+AclipmapWaterActor::AclipmapWaterActor() : AcustomMeshActorBase()
+{
+ 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	PrimaryActorTick.bCanEverTick = true;
+
+    meshInited = false;
+    setTeam(teamEnum::neutralTeam);
+}
+
+void AclipmapWaterActor::BeginPlay(){
+    Super::BeginPlay();
+    setTeam(teamEnum::neutralTeam);
+}
+
+void AclipmapWaterActor::Tick(float DeltaTime){
+    Super::Tick(DeltaTime);
+
+    if(!meshInited){
+        return;
+    }
+
+    //after a snap every vertex shows another spot of the waves, all levels refresh
+    bool moved = followPlayer();
+    if(moved){
+        trianglesDirty = true;
+    }
+    if(trianglesDirty){
+        rebuildTriangles();
+    }
+    TickRipples(DeltaTime); //tick ripples before vertex shader to already modify mesh
+    vertexShader(moved);
+}
+
+void AclipmapWaterActor::EndPlay(const EEndPlayReason::Type EndPlayReason){
+    WaterUpdateScheduler *scheduler = WaterUpdateScheduler::instance();
+    for (int i = 0; i < levelPaneIds.size(); i++){
+        scheduler->unregisterPane(levelPaneIds[i]);
+    }
+    levelPaneIds.clear();
+    Super::EndPlay(EndPlayReason);
+}
+
+
+/// @brief spawns the clipmap below the player at the given height
+/// @param world world to spawn in
+/// @param height water height in world space
+/// @return spawned actor or nullptr
+AclipmapWaterActor *AclipmapWaterActor::spawnClipmap(
+    UWorld *world,
+    float height
+){
+    if(world == nullptr){
+        return nullptr;
+    }
+
+    FVector location = PlayerInfo::playerLocation();
+    location.Z = height;
+
+    FActorSpawnParameters params;
+    AclipmapWaterActor *SpawnedActor = world->SpawnActor<AclipmapWaterActor>(
+        AclipmapWaterActor::StaticClass(),
+        location,
+        FRotator::ZeroRotator,
+        params
+    );
+    if(SpawnedActor != nullptr){
+        SpawnedActor->createClipmap();
+        SpawnedActor->followPlayer();
+    }
+    return SpawnedActor;
+}
+
+
+/**
+ *
+ * --- clipmap grid ---
+ *
+ */
+
+/// @brief vertex distance of a level in cm, doubles with each level
+int AclipmapWaterActor::vertexDistanceForLevel(int level){
+    return BASE_VERTEX_DISTANCE << level;
+}
+
+/// @brief the actor snaps to the vertex distance of the coarsest level
+int AclipmapWaterActor::snapDistance(){
+    return vertexDistanceForLevel(LEVELS - 1);
+}
+
+/// @brief local position of vertex (0,0) of a level, all levels are centered on the actor
+FVector AclipmapWaterActor::levelOrigin(int level){
+    float halfSize = (GRID_QUADS * vertexDistanceForLevel(level)) / 2.0f;
+    return FVector(-halfSize, -halfSize, 0);
+}
+
+/// @brief the inner half of a level is covered by the next finer level
+bool AclipmapWaterActor::isInsideHole(int x, int y){
+    int from = GRID_QUADS / 4;
+    int to = (GRID_QUADS * 3) / 4;
+    return x >= from && x < to && y >= from && y < to;
+}
+
+/// @brief creates all levels into one mesh, level 0 comes first as a full
+/// x major grid, the other levels are addressed through their index map
+void AclipmapWaterActor::createClipmap(){
+    if(meshInited){
+        return;
+    }
+
+    TArray<FVector> vertecies;
+    stitchTriples.clear();
+    quadCorners.clear();
+    outerBorder.clear();
+    levelIndexMaps.clear();
+    levelIndexMaps.resize(LEVELS);
+    levelFirstVertex.clear();
+
+    for (int level = 0; level < LEVELS; level++){
+        levelFirstVertex.push_back(vertecies.Num());
+        buildLevel(level, vertecies);
+    }
+    buildSkirt(vertecies);
+    levelFirstVertex.push_back(vertecies.Num());
+    buildSeamPairs();
+    setupWaveFade();
+
+    //all quads for the first upload, normals are computed once from them
+    TArray<int32> triangles;
+    triangles.Reserve((quadCorners.size() / 4) * 6);
+    for (int i = 0; i + 3 < quadCorners.size(); i += 4){
+        triangles.Add(quadCorners[i]);
+        triangles.Add(quadCorners[i + 1]);
+        triangles.Add(quadCorners[i + 2]);
+
+        triangles.Add(quadCorners[i]);
+        triangles.Add(quadCorners[i + 2]);
+        triangles.Add(quadCorners[i + 3]);
+    }
+
+    MeshData &waterMesh = findMeshDataReference(
+        materialEnum::waterMaterial,
+        ELod::lodNear
+    );
+    waterMesh.rebuild(MoveTemp(vertecies), MoveTemp(triangles));
+
+    ReloadMeshAndApplyAllMaterials();
+    meshInited = true;
+    trianglesDirty = true;
+
+    //rest positions of each level, loaded once, the actor moves by its transform
+    TArray<FVector> &meshVertecies = waterMesh.getVerteciesRef();
+    levelBatches.clear();
+    levelBatches.resize(LEVELS);
+    for (int level = 0; level < LEVELS; level++){
+        int first = levelFirstVertex[level];
+        levelBatches[level].load(meshVertecies, first, levelFirstVertex[level + 1] - first);
+    }
+    registerLevels();
+
+    //update collsion params for this mesh after it was setup
+    UProceduralMeshComponent *thisMesh = meshComponentPointer();
+    if (thisMesh)
+    {
+        thisMesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+        thisMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
+        thisMesh->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
+    }
+}
+
+/// @brief appends one level, levels above 0 leave out the quads of the hole
+/// and only add the vertecies they reference
+/// @param level level to build
+/// @param vertecies vertecies to append to, the quads are saved in quadCorners
+void AclipmapWaterActor::buildLevel(
+    int level,
+    TArray<FVector> &vertecies
+){
+    int verteciesPerAxis = GRID_QUADS + 1;
+    int detail = vertexDistanceForLevel(level);
+    FVector origin = levelOrigin(level);
+    bool hasHole = level > 0;
+
+    //grid index to mesh index, -1 for unused
+    std::vector<int> &indexMap = levelIndexMaps[level];
+    indexMap.assign(verteciesPerAxis * verteciesPerAxis, -1);
+    for (int x = 0; x < GRID_QUADS; x++){
+        for (int y = 0; y < GRID_QUADS; y++){
+            if(hasHole && isInsideHole(x, y)){
+                continue;
+            }
+            indexMap[x * verteciesPerAxis + y] = 0;
+            indexMap[x * verteciesPerAxis + (y + 1)] = 0;
+            indexMap[(x + 1) * verteciesPerAxis + (y + 1)] = 0;
+            indexMap[(x + 1) * verteciesPerAxis + y] = 0;
+        }
+    }
+
+    for (int x = 0; x < verteciesPerAxis; x++){
+        for (int y = 0; y < verteciesPerAxis; y++){
+            int &mapped = indexMap[x * verteciesPerAxis + y];
+            if(mapped < 0){
+                continue;
+            }
+            mapped = vertecies.Num();
+            vertecies.Add(origin + FVector(x * detail, y * detail, 0));
+        }
+    }
+
+    for (int x = 0; x < GRID_QUADS; x++){
+        for (int y = 0; y < GRID_QUADS; y++){
+            if(hasHole && isInsideHole(x, y)){
+                continue;
+            }
+            /*
+            1 2
+            0 3
+            */
+            int v0 = indexMap[x * verteciesPerAxis + y];
+            int v1 = indexMap[x * verteciesPerAxis + (y + 1)];
+            int v2 = indexMap[(x + 1) * verteciesPerAxis + (y + 1)];
+            int v3 = indexMap[(x + 1) * verteciesPerAxis + y];
+            appendQuad(v0, v1, v2, v3);
+        }
+    }
+
+    //the outer border touches the hole of the next level, every second border
+    //vertex lies between two coarse vertecies and must follow their line.
+    //The last level is continued by the skirt instead
+    if(level >= LEVELS - 1){
+        for (int i = 0; i < 4 * GRID_QUADS; i++){
+            int x, y;
+            borderCoordinate(i, x, y);
+            outerBorder.push_back(indexMap[x * verteciesPerAxis + y]);
+        }
+        return;
+    }
+    int last = GRID_QUADS;
+    for (int i = 1; i < last; i += 2){
+        int borderX[4] = {0, last, i, i};
+        int borderY[4] = {i, i, 0, last};
+        bool alongY[4] = {true, true, false, false};
+        for (int side = 0; side < 4; side++){
+            int x = borderX[side];
+            int y = borderY[side];
+            int ax = alongY[side] ? x : x - 1;
+            int ay = alongY[side] ? y - 1 : y;
+            int bx = alongY[side] ? x : x + 1;
+            int by = alongY[side] ? y + 1 : y;
+
+            stitchTriples.push_back(indexMap[x * verteciesPerAxis + y]);
+            stitchTriples.push_back(indexMap[ax * verteciesPerAxis + ay]);
+            stitchTriples.push_back(indexMap[bx * verteciesPerAxis + by]);
+        }
+    }
+}
+
+/// @brief walks the outer border of a level grid counter clockwise,
+/// index 0 is the corner (0,0), GRID_QUADS indices per side
+void AclipmapWaterActor::borderCoordinate(int index, int &x, int &y){
+    int side = index / GRID_QUADS;
+    int t = index % GRID_QUADS;
+    int last = GRID_QUADS;
+    int xs[4] = {t, last, last - t, 0};
+    int ys[4] = {0, t, last, last - t};
+    x = xs[side % 4];
+    y = ys[side % 4];
+}
+
+/// @brief flat rings around the last level up to the horizon, each ring doubles
+/// the half size and keeps the vertex count of the border. The first ring uses the
+/// border vertecies of the last level itself, so the seam can not open
+void AclipmapWaterActor::buildSkirt(TArray<FVector> &vertecies){
+    int count = outerBorder.size();
+    if(count == 0){
+        return;
+    }
+    float halfSize = -levelOrigin(LEVELS - 1).X;
+
+    std::vector<int> inner = outerBorder;
+    std::vector<int> outer(count, -1);
+    for (int ring = 0; ring < SKIRT_RINGS; ring++){
+        halfSize *= 2.0f;
+        for (int i = 0; i < count; i++){
+            int x, y;
+            borderCoordinate(i, x, y);
+            float px = ((2.0f * x) / GRID_QUADS - 1.0f) * halfSize;
+            float py = ((2.0f * y) / GRID_QUADS - 1.0f) * halfSize;
+            outer[i] = vertecies.Num();
+            vertecies.Add(FVector(px, py, 0));
+        }
+
+        //same winding as the level quads (facing up)
+        for (int i = 0; i < count; i++){
+            int next = (i + 1) % count;
+            appendQuad(inner[i], inner[next], outer[next], outer[i]);
+        }
+        inner = outer;
+    }
+}
+
+void AclipmapWaterActor::appendQuad(int32 v0, int32 v1, int32 v2, int32 v3){
+    quadCorners.push_back(v0);
+    quadCorners.push_back(v1);
+    quadCorners.push_back(v2);
+    quadCorners.push_back(v3);
+}
+
+/**
+ *
+ * --- ocean areas ---
+ *
+ */
+
+/// @brief registers a square area which is covered by water, usually one ocean chunk
+/// @param bottomLeft lower corner of the area in world space
+/// @param size side length in cm, all areas are expected to share the size
+void AclipmapWaterActor::addOceanArea(FVector &bottomLeft, float size){
+    if(size <= 0.0f){
+        return;
+    }
+    if(oceanCellSize <= 0.0f){
+        oceanCellSize = size;
+    }
+    int x = std::floor((bottomLeft.X + size / 2.0f) / oceanCellSize);
+    int y = std::floor((bottomLeft.Y + size / 2.0f) / oceanCellSize);
+    if(oceanCells.insert(std::pair<int, int>(x, y)).second){
+        trianglesDirty = true;
+    }
+}
+
+/// @brief true if the world space rectangle overlaps any ocean cell
+bool AclipmapWaterActor::touchesOcean(FVector2D &min, FVector2D &max){
+    if(oceanCellSize <= 0.0f){
+        return false;
+    }
+    int minX = std::floor(min.X / oceanCellSize);
+    int minY = std::floor(min.Y / oceanCellSize);
+    int maxX = std::floor(max.X / oceanCellSize);
+    int maxY = std::floor(max.Y / oceanCellSize);
+    for (int x = minX; x <= maxX; x++){
+        for (int y = minY; y <= maxY; y++){
+            if(oceanCells.find(std::pair<int, int>(x, y)) != oceanCells.end()){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/// @brief keeps only the quads over ocean, a quad partly over land is kept,
+/// the terrain there is above the water anyway
+void AclipmapWaterActor::rebuildTriangles(){
+    trianglesDirty = false;
+
+    MeshData &waterMesh = findMeshDataReference(
+        materialEnum::waterMaterial,
+        ELod::lodNear
+    );
+    TArray<FVector> &vertecies = waterMesh.getVerteciesRef();
+    FVector actorLocation = GetActorLocation();
+    FVector2D offset(actorLocation.X, actorLocation.Y);
+
+    TArray<int32> triangles;
+    triangles.Reserve((quadCorners.size() / 4) * 6);
+    for (int i = 0; i + 3 < quadCorners.size(); i += 4){
+        FVector2D min(vertecies[quadCorners[i]]);
+        FVector2D max = min;
+        for (int j = 1; j < 4; j++){
+            FVector2D corner(vertecies[quadCorners[i + j]]);
+            min = FVector2D::Min(min, corner);
+            max = FVector2D::Max(max, corner);
+        }
+        min += offset;
+        max += offset;
+        if(!touchesOcean(min, max)){
+            continue;
+        }
+        triangles.Add(quadCorners[i]);
+        triangles.Add(quadCorners[i + 1]);
+        triangles.Add(quadCorners[i + 2]);
+
+        triangles.Add(quadCorners[i]);
+        triangles.Add(quadCorners[i + 2]);
+        triangles.Add(quadCorners[i + 3]);
+    }
+
+    //the triangle buffer can only be replaced by recreating the section
+    waterMesh.getTrianglesRef() = MoveTemp(triangles);
+    ReloadMeshForMaterial(materialEnum::waterMaterial);
+}
+
+/// @brief pairs the even outer border vertecies of each level with the vertex at the
+/// same position on the hole border of the next coarser level
+void AclipmapWaterActor::buildSeamPairs(){
+    seamPairs.clear();
+    int verteciesPerAxis = GRID_QUADS + 1;
+    int quarter = GRID_QUADS / 4;
+    for (int level = 0; level + 1 < LEVELS; level++){
+        std::vector<int> &fine = levelIndexMaps[level];
+        std::vector<int> &coarse = levelIndexMaps[level + 1];
+        for (int i = 0; i < 4 * GRID_QUADS; i += 2){
+            int x, y;
+            borderCoordinate(i, x, y);
+            int fineIndex = fine[x * verteciesPerAxis + y];
+            int coarseIndex = coarse[(quarter + x / 2) * verteciesPerAxis + (quarter + y / 2)];
+            if(fineIndex >= 0 && coarseIndex >= 0){
+                seamPairs.push_back(fineIndex);
+                seamPairs.push_back(coarseIndex);
+            }
+        }
+    }
+}
+
+/// @brief the coarser level is the reference on a seam, it may have been refreshed
+/// in another frame than the finer level
+void AclipmapWaterActor::copySeamsFromCoarse(TArray<FVector> &vertecies){
+    for (int i = 0; i + 1 < seamPairs.size(); i += 2){
+        vertecies[seamPairs[i]].Z = vertecies[seamPairs[i + 1]].Z;
+    }
+}
+
+/// @brief closes the t junctions between two levels after the waves were applied
+void AclipmapWaterActor::stitchLevelBorders(TArray<FVector> &vertecies){
+    for (int i = 0; i + 2 < stitchTriples.size(); i += 3){
+        FVector &vertex = vertecies[stitchTriples[i]];
+        FVector &a = vertecies[stitchTriples[i + 1]];
+        FVector &b = vertecies[stitchTriples[i + 2]];
+        vertex.Z = (a.Z + b.Z) / 2.0f;
+    }
+}
+
+/// @brief snaps the actor below the player, on the coarsest grid
+/// @return true if the actor moved
+bool AclipmapWaterActor::followPlayer(){
+    FVector playerLocation = PlayerInfo::playerLocation();
+    FVector actorLocation = GetActorLocation();
+
+    float snap = snapDistance();
+    FVector snapped(
+        std::round(playerLocation.X / snap) * snap,
+        std::round(playerLocation.Y / snap) * snap,
+        actorLocation.Z
+    );
+
+    if(snapped.X != actorLocation.X || snapped.Y != actorLocation.Y){
+        SetActorLocation(snapped);
+        return true;
+    }
+    return false;
+}
+
+
+/**
+ *
+ * --- vertex shader ---
+ *
+ */
+
+/**
+ *
+ * --- level scheduling ---
+ *
+ */
+
+/// @brief distance from the center to the inner border of a level, the scheduler
+/// bands the level by it
+float AclipmapWaterActor::levelInnerDistance(int level){
+    if(level <= 0){
+        return 0.0f;
+    }
+    return -levelOrigin(level - 1).X;
+}
+
+void AclipmapWaterActor::registerLevels(){
+    WaterUpdateScheduler *scheduler = WaterUpdateScheduler::instance();
+    for (int i = 0; i < levelPaneIds.size(); i++){
+        scheduler->unregisterPane(levelPaneIds[i]);
+    }
+    levelPaneIds.clear();
+    for (int level = 0; level < LEVELS; level++){
+        levelPaneIds.push_back(scheduler->registerPane());
+    }
+}
+
+/// @brief reports all levels to the WaterUpdateScheduler and refreshes the ones it
+/// selects, then the seams are closed and the mesh is uploaded if anything changed
+/// @param allLevels refresh every level, after the actor snapped
+void AclipmapWaterActor::vertexShader(bool allLevels){
+    UProceduralMeshComponent *thisMesh = meshComponentPointer();
+    if(!thisMesh || levelPaneIds.size() < LEVELS){
+        return;
+    }
+
+    MeshData &waterMesh = findMeshDataReference(
+        materialEnum::waterMaterial,
+        ELod::lodNear
+    );
+    TArray<FVector> &vertecies = waterMesh.getVerteciesRef();
+    int layer = layerByMaterialEnum(materialEnum::waterMaterial);
+
+    WaterUpdateScheduler *scheduler = WaterUpdateScheduler::instance();
+    FVector actorLocation = GetActorLocation();
+    float time = waveTime();
+    bool ripplesActive = rippleField.hasRipples();
+    for (int level = 0; level < LEVELS; level++){
+        FVector location = actorLocation + FVector(levelInnerDistance(level), 0, 0);
+        //flat levels keep their wave time, they only change with ripples
+        float levelTime = level < firstFlatLevel ? time : 0.0f;
+        scheduler->reportPane(levelPaneIds[level], location, true, ripplesActive, levelTime);
+    }
+
+    bool anyUpdated = false;
+    for (int level = 0; level < LEVELS; level++){
+        if(!allLevels && !scheduler->shouldUpdate(levelPaneIds[level])){
+            continue;
+        }
+        shadeLevel(level, vertecies);
+        scheduler->markUpdated(levelPaneIds[level]);
+        anyUpdated = true;
+    }
+    if(!anyUpdated){
+        return;
+    }
+
+    copySeamsFromCoarse(vertecies);
+    stitchLevelBorders(vertecies);
+    refreshMesh(*thisMesh, waterMesh, layer);
+}
+
+/// @brief waves and ripples for one level, the skirt is shaded with the last level
+void AclipmapWaterActor::shadeLevel(int level, TArray<FVector> &vertecies){
+    VertexBatch &batch = levelBatches[level];
+    applyShaderToBatch(batch);
+    batch.storeHeights(vertecies);
+    applyRipples(vertecies, level);
+}
+
+/// @brief applies the ripples to one level, the ring visits only the vertecies it
+/// overlaps. Levels share their border vertecies positions, so both sides of a seam
+/// get the same ripple height
+void AclipmapWaterActor::applyRipples(TArray<FVector> &vertecies, int level){
+    if(!rippleField.hasRipples() || level < 0 || level >= levelIndexMaps.size()){
+        return;
+    }
+    FVector actorLocation = GetActorLocation();
+    FVector gridOffset = levelOrigin(level);
+    rippleField.apply(
+        vertecies,
+        GRID_QUADS,
+        vertexDistanceForLevel(level),
+        actorLocation,
+        gridOffset,
+        levelIndexMaps[level]
+    );
+}
+
+/// @brief apply vertex shader to the given vertex
+/// @param vertex vertex to move
+void AclipmapWaterActor::applyShaderToVertex(FVector &vertex){
+    FVector actorLocation = GetActorLocation();
+    waveKernel.setup(actorLocation, waveTime());
+    vertex.Z = waveKernel.evaluate(vertex.X, vertex.Y);
+}
+
+/// @brief applies the waves to all vertecies of the batch (simd)
+/// @param batch batch to modify
+void AclipmapWaterActor::applyShaderToBatch(VertexBatch &batch){
+    FVector actorLocation = GetActorLocation();
+    waveKernel.setup(actorLocation, waveTime());
+    batch.run(waveKernel);
+}
+
+/// @brief a level needs less than half the shortest wavelength as vertex distance,
+/// from the first level past that limit on the surface is flat. The fade runs over the
+/// level before it and depends on the position only, shared border vertecies of two
+/// levels get the same height
+void AclipmapWaterActor::setupWaveFade(){
+    float wavelength = waveKernel.shortestWavelength();
+    firstFlatLevel = LEVELS;
+    for (int level = 0; level < LEVELS; level++){
+        if(2.0f * vertexDistanceForLevel(level) >= wavelength){
+            firstFlatLevel = level;
+            break;
+        }
+    }
+    if(firstFlatLevel >= LEVELS){
+        waveKernel.setDistanceFade(-1.0f, -1.0f);
+        return;
+    }
+
+    //outer half size of a level, the hole of the next level
+    float zeroFrom = 0.0f;
+    float fullUntil = 0.0f;
+    if(firstFlatLevel > 0){
+        zeroFrom = -levelOrigin(firstFlatLevel - 1).X;
+        fullUntil = zeroFrom / 2.0f;
+    }
+    waveKernel.setDistanceFade(fullUntil, zeroFrom);
+}
+
+/// @brief world time, same wave phase as the old water panes
+float AclipmapWaterActor::waveTime(){
+    UWorld *world = GetWorld();
+    if(world){
+        return world->GetTimeSeconds();
+    }
+    return shaderRunningTime;
+}
+
+void AclipmapWaterActor::refreshMesh(
+    UProceduralMeshComponent& meshComponent,
+    MeshData &other,
+    int layer
+){
+    if(meshInited){
+        Super::refreshMesh(meshComponent, other, layer);
+    }
+}
+
+MeshData& AclipmapWaterActor::findMeshDataReference(
+    materialEnum mat,
+    ELod lod
+){
+    return Super::findMeshDataReference(
+        mat,
+        lod,
+        true // mesh
+    );
+}
+
+UProceduralMeshComponent* AclipmapWaterActor::meshComponentPointer(){
+    if(Mesh){
+        return Mesh;
+    }
+    return nullptr;
+}
+
+
+/**
+ * -- damage interaction --
+ */
+void AclipmapWaterActor::setTeam(teamEnum t){
+    teamSaved = t;
+}
+
+teamEnum AclipmapWaterActor::getTeam(){
+    return teamSaved;
+}
+
+void AclipmapWaterActor::takedamage(int d){
+    //nicht reagieren
+}
+
+void AclipmapWaterActor::takedamage(int d, FVector &hitpoint){
+    addNewRipple(hitpoint);
+}
+
+void AclipmapWaterActor::takedamage(int d, bool surpressed){
+    takedamage(d);
+}
+void AclipmapWaterActor::takedamage(int d, FVector &hitpoint, bool surpressed){
+    takedamage(d, hitpoint);
+}
+
+/**
+ *
+ * -- ripple index management --
+ *
+*/
+void AclipmapWaterActor::TickRipples(float DeltaTime){
+    rippleField.tick(DeltaTime);
+}
+
+///@brief starts a new ripple, the radius is the size of the finest level
+void AclipmapWaterActor::addNewRipple(FVector &location){
+    float maxRadius = (GRID_QUADS * vertexDistanceForLevel(0)) / 2.0f;
+    rippleField.add(location, maxRadius);
+}
@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameCore/MeshGenBase/customMeshActorBase.h"
+#include "GameCore/interfaces/DamageInterface.h"
+#include "terrainPlugin/meshgen/water/RippleField.h"
+#include "terrainPlugin/meshgen/water/shader/WaveKernel.h"
+#include <vector>
+#include <set>
+#include "clipmapWaterActor.generated.h"
+
+/**
+ * one water surface for the whole ocean, centered on the player.
+ * Nested square rings (levels), each level has the same quad count but double the
+ * vertex distance of the level inside. The actor snaps to the coarsest vertex distance,
+ * so every vertex stays on its own grid and the waves dont swim while the player moves.
+ * The vertex count is constant, no matter how much ocean is visible.
+ * Levels whose vertex distance is past the Nyquist limit of the shortest wave stay flat,
+ * the waves fade out over the last level which can still show them.
+ * A flat skirt of rings continues the outer level to the horizon. Only quads above
+ * registered ocean areas are drawn, the triangle list is rebuilt when the actor snaps
+ * or a new ocean area is added.
+ * Every level is a pane of the WaterUpdateScheduler, coarse levels are far away by
+ * their inner distance and refresh less often. The seam vertecies of a finer level take
+ * the heights of the coarser level, so levels refreshed in different frames stay closed.
+ */
+UCLASS()
+class TERRAINPLUGIN_API AclipmapWaterActor : public AcustomMeshActorBase, public IDamageinterface
+{
+	GENERATED_BODY()
+
+public:
+	AclipmapWaterActor();
+
+	virtual void BeginPlay() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void takedamage(int d) override;
+	virtual void takedamage(int d, FVector &from) override;
+	virtual void takedamage(int d, bool surpressed) override;
+	virtual void takedamage(int d, FVector &hitpoint, bool surpressed) override;
+
+	virtual void setTeam(teamEnum t) override;
+	virtual teamEnum getTeam() override;
+
+	void createClipmap();
+
+	static AclipmapWaterActor *spawnClipmap(
+		UWorld *world,
+		float height
+	);
+
+	void addOceanArea(FVector &bottomLeft, float size);
+
+protected:
+	static const int LEVELS = 5;
+	static const int GRID_QUADS = 32; //per axis and level, multiple of 4
+	static const int BASE_VERTEX_DISTANCE = 100;
+	static const int SKIRT_RINGS = 4; //each ring doubles the half size
+
+	teamEnum teamSaved = teamEnum::none;
+
+	bool meshInited = false;
+
+	int vertexDistanceForLevel(int level);
+	int snapDistance();
+	FVector levelOrigin(int level);
+
+	void buildLevel(
+		int level,
+		TArray<FVector> &vertecies
+	);
+	bool isInsideHole(int x, int y);
+	void borderCoordinate(int index, int &x, int &y);
+	void buildSkirt(TArray<FVector> &vertecies);
+
+	bool followPlayer();
+
+	//all quads of levels and skirt, 4 mesh indices each in triangle winding
+	std::vector<int32> quadCorners;
+	void appendQuad(int32 v0, int32 v1, int32 v2, int32 v3);
+
+	//outer border of the last level, see borderCoordinate for the order
+	std::vector<int> outerBorder;
+
+	//chunks with ocean, quads not touching any of them are left out
+	float oceanCellSize = 0.0f;
+	std::set<std::pair<int, int>> oceanCells;
+	bool trianglesDirty = true;
+	bool touchesOcean(FVector2D &min, FVector2D &max);
+	void rebuildTriangles();
+
+	//grid index x * (GRID_QUADS + 1) + y to mesh index per level, -1 inside the hole
+	std::vector<std::vector<int>> levelIndexMaps;
+
+	//first vertex of each level, the skirt belongs to the last level, LEVELS + 1 entries
+	std::vector<int> levelFirstVertex;
+	std::vector<VertexBatch> levelBatches;
+	std::vector<int> levelPaneIds;
+	float levelInnerDistance(int level);
+	void registerLevels();
+
+	//even outer border vertex of a level and the same vertex of the coarser level
+	std::vector<int> seamPairs;
+	void buildSeamPairs();
+	void copySeamsFromCoarse(TArray<FVector> &vertecies);
+
+	//outer border vertecies between two coarse vertecies: vertex, neighbour a, neighbour b
+	std::vector<int> stitchTriples;
+	void stitchLevelBorders(TArray<FVector> &vertecies);
+
+	//only update if mesh was inited
+	virtual void refreshMesh(
+		UProceduralMeshComponent &meshComponent,
+		MeshData &other,
+		int layer
+	) override;
+
+	void vertexShader(bool allLevels);
+	void shadeLevel(int level, TArray<FVector> &vertecies);
+	virtual void applyShaderToVertex(FVector &vertex) override;
+	virtual void applyShaderToBatch(VertexBatch &batch) override;
+	WaveKernel waveKernel;
+	float waveTime();
+	int firstFlatLevel = LEVELS;
+	void setupWaveFade();
+
+	//ripples on every level the ring overlaps
+	RippleField rippleField;
+	void applyRipples(TArray<FVector> &vertecies, int level);
+	void TickRipples(float DeltaTime);
+	void addNewRipple(FVector &location);
+
+	//helper for mesh
+	MeshData &findMeshDataReference(
+		materialEnum mat,
+		ELod lod
+	);
+	UProceduralMeshComponent *meshComponentPointer();
+};
@@ -7,6 +7,8 @@
 #include "CoreMath/Matrix/MMatrix.h"
 #include "GameCore/PlayerInfo/PlayerInfo.h"
 #include "ripple.h"
+#include "terrainPlugin/meshgen/water/WaterGridTemplate.h"
+#include "terrainPlugin/meshgen/water/WaterUpdateScheduler.h"
 
 
 AcustomWaterActor::AcustomWaterActor() : AcustomMeshActorBase()
@@ -33,13 +35,31 @@ void AcustomWaterActor::Tick(float DeltaTime){
         return;
     }
 
-    if (playerIsInRenderRange()){
+    bool visible = playerIsInRenderRange();
+    WaterUpdateScheduler *scheduler = WaterUpdateScheduler::instance();
+    FVector location = GetActorLocation();
+    scheduler->reportPane(schedulerPaneId, location, visible, rippleField.hasRipples(), waveTime());
+
+    if (visible){
         //updateRunningTime(DeltaTime);
         TickRipples(DeltaTime); //tick ripples before vertex shader to already modify mesh
-        vertexShader();
+
+        //refresh budget and rate by distance are shared by all panes
+        if(scheduler->shouldUpdate(schedulerPaneId)){
+            vertexShader();
+            scheduler->markUpdated(schedulerPaneId);
+        }
     }
 }
 
+void AcustomWaterActor::EndPlay(const EEndPlayReason::Type EndPlayReason){
+    if(schedulerPaneId >= 0){
+        WaterUpdateScheduler::instance()->unregisterPane(schedulerPaneId);
+        schedulerPaneId = -1;
+    }
+    Super::EndPlay(EndPlayReason);
+}
+
 
 void AcustomWaterActor::createWaterPane(
     UWorld *world, 
@@ -55,12 +75,14 @@ void AcustomWaterActor::createWaterPane(
 
     int vertexCount = scaleMeters / DEFAULT_DISTANCE_BETWEEN_VERTECIES;
 
-    int paneCount = vertexCount / MAX_VERTEXCOUNT;
+    //split the area into equal panes so all of them share one grid
+    int paneCount = (vertexCount + MAX_VERTEXCOUNT - 1) / MAX_VERTEXCOUNT;
     if(paneCount == 0){ //below max size, do 1
         paneCount = 1;
     }
+    int quadsPerPane = (vertexCount + paneCount - 1) / paneCount;
 
-    int offsetOnAxis = MAX_VERTEXCOUNT * DEFAULT_DISTANCE_BETWEEN_VERTECIES;
+    int offsetOnAxis = quadsPerPane * DEFAULT_DISTANCE_BETWEEN_VERTECIES;
 
     DebugHelper::logMessage("DEBUGSIZE OF WATER VERTEXCOUNT", vertexCount);
     DebugHelper::logMessage("DEBUGSIZE OF WATER PANECOUNT", paneCount);
@@ -71,9 +93,10 @@ void AcustomWaterActor::createWaterPane(
     for (int i = 0; i < paneCount; i++){
         for (int j = 0; j < paneCount; j++){
 
+            //exact grid position, nothing is accumulated
             FVector finalLocation = offsetVector;
-            offsetVector.X += offsetOnAxis * i;
-            offsetVector.Y += offsetOnAxis * j;
+            finalLocation.X += offsetOnAxis * i;
+            finalLocation.Y += offsetOnAxis * j;
 
             FRotator rotation;
             FActorSpawnParameters params;
@@ -85,7 +108,7 @@ void AcustomWaterActor::createWaterPane(
             );
             if(SpawnedActor != nullptr){
                 SpawnedActor->createWaterPane(
-                    vertexCount, 
+                    quadsPerPane, 
                     DEFAULT_DISTANCE_BETWEEN_VERTECIES
                 );
             }
@@ -96,9 +119,8 @@ void AcustomWaterActor::createWaterPane(
 
 
 
-/// @brief 
-/// @param sizeX in vertecies
-/// @param sizeY in vertecies
+/// @brief creates the pane from the shared water grid, the location is the actor transform
+/// @param vertexCountIn quads per axis
 /// @param detail detail between vertecies (in cm)
 void AcustomWaterActor::createWaterPane(int vertexCountIn, int detail){
     if(meshInited){
@@ -115,6 +137,7 @@ void AcustomWaterActor::createWaterPane(int vertexCountIn, int detail){
 
     vertexcountX = vertexCountIn;
     vertexcountY = vertexCountIn;
+    vertexDistance = detail;
 
     //VERY IMPORTANT
     BottomLeft = FVector(0,0,0);
@@ -129,26 +152,12 @@ void AcustomWaterActor::createWaterPane(int vertexCountIn, int detail){
         ELod::lodNear
     );
 
-    for (int i = 0; i < vertexcountX; i++){
-        for (int j = 0; j < vertexcountY; j++){
-            int xOffset = i * detail;
-            int yOffset = j * detail;
-            /*
-            1 2
-            0 3
-            */
-            FVector v0 = FVector(xOffset, yOffset, 0);
-            FVector v1 = FVector(xOffset, yOffset + detail, 0);
-            FVector v2 = FVector(xOffset + detail, yOffset + detail, 0);
-            FVector v3 = FVector(xOffset + detail, yOffset, 0);
-
-            waterMesh.appendEfficent(v0, v1, v2, v3);
-        }
-    }
-    waterMesh.calculateNormals();
+    //shared grid, built once for all panes of this size, only copied here
+    waterMesh = WaterGridTemplate::instance()->gridFor(vertexCountIn, detail);
 
     ReloadMeshAndApplyAllMaterials();
     meshInited = true;
+    schedulerPaneId = WaterUpdateScheduler::instance()->registerPane();
 
 
     //exclude this for bone controller raycast
@@ -190,6 +199,7 @@ UProceduralMeshComponent* AcustomWaterActor::meshComponentPointer(){
 }
 
 
+/// @brief runs the waves and ripples, the WaterUpdateScheduler decides when
 void AcustomWaterActor::vertexShader(){
     MeshData &waterMesh = findMeshDataReference(
         materialEnum::waterMaterial,
@@ -198,38 +208,29 @@ void AcustomWaterActor::vertexShader(){
 
     int layer = layerByMaterialEnum(materialEnum::waterMaterial);
 
-    FVector locationOfPlayer = PlayerInfo::playerLocation();
-
     //raycast is not blocked by water
     UProceduralMeshComponent *thisMesh = meshComponentPointer();
     if(thisMesh){
-        TArray<FVector> &vertecies = waterMesh.getVerteciesRef();
+        //waves for all vertecies in one batch
+        vertexShaderBatchFor(waterMesh);
 
-        //old working, linear: bad
-        
+        TArray<FVector> &vertecies = waterMesh.getVerteciesRef();
         FVector actorLocation = GetActorLocation();
-        for (int i = 0; i < vertecies.Num(); i++)
-        {
-            if(i >= 0 && i < vertecies.Num()){
-                FVector &vertex = vertecies[i];
 
-                if(!isAtLockedAxis(vertex)){
-                    applyShaderToVertex(vertex);
-                    applyWaterRippleOffset(vertex, actorLocation);
-                }else{
-                    //debug draw shows it should be fine, somewhere the flag gets resettet
-                    /*
-                    DebugHelper::showLineBetween(
-                        GetWorld(),
-                        GetActorLocation() + vertex,
-                        GetActorLocation() + vertex + FVector(0, 0, 1000),
-                        FColor::Orange,
-                        0.1f
-                    );*/
+        //ripples only touch the vertecies inside their rings
+        if(rippleField.hasRipples()){
+            rippleField.apply(vertecies, vertexcountX, vertexDistance, actorLocation);
+        }
+
+        bool anyAxisLocked = topAxisLocked || bottomAxisLocked || leftAxisLocked || rightAxisLocked;
+        if(anyAxisLocked){
+            for (int i = 0; i < vertecies.Num(); i++)
+            {
+                FVector &vertex = vertecies[i];
+                if(isAtLockedAxis(vertex)){
                     resetVertexShadignFor(vertex);
                 }
             }
-            
         }
 
         refreshMesh(*thisMesh, waterMesh, layer);
@@ -269,20 +270,29 @@ bool AcustomWaterActor::isAtLockedAxis(FVector &other){
 /// @param vertex vertex to move
 void AcustomWaterActor::applyShaderToVertex(FVector &vertex){
     FVector actorLocation = GetActorLocation();
-    float distXAll = vertex.X + actorLocation.X;
-    float distYAll = vertex.Y + actorLocation.Y;
+    waveKernel.setup(actorLocation, waveTime());
+    vertex.Z = waveKernel.evaluate(vertex.X, vertex.Y);
+}
 
-    float frequency = 0.01f; // Wellenbreite
-    float amplitude = 10.0f; // Wellenhöhe
-    float speed = 1.0f; // Wellengeschwindigkeit //1.0;
-    float wave = sin(distXAll * frequency + shaderRunningTime * speed) + 
-                 cos(distYAll * frequency + shaderRunningTime * speed);
+/// @brief applies the waves to all vertecies of the batch (simd)
+/// @param batch batch to modify
+void AcustomWaterActor::applyShaderToBatch(VertexBatch &batch){
+    FVector actorLocation = GetActorLocation();
+    waveKernel.setup(actorLocation, waveTime());
+    batch.run(waveKernel);
+}
 
-    vertex.Z = wave * amplitude;
 
+/// @brief world time for all panes, neighbouring panes are in the same wave phase
+/// and share the blended frame of the wave tile
+float AcustomWaterActor::waveTime(){
+    UWorld *world = GetWorld();
+    if(world){
+        return world->GetTimeSeconds();
+    }
+    return shaderRunningTime;
 }
 
-
 void AcustomWaterActor::resetAllShaderOffsets(){
     UProceduralMeshComponent *thisMesh = meshComponentPointer();
     if(thisMesh){
@@ -354,74 +364,12 @@ void AcustomWaterActor::takedamage(int d, FVector &hitpoint, bool surpressed){
  * 
 */
 void AcustomWaterActor::TickRipples(float DeltaTime){
-    std::vector<int> markedForRemoval;
-    for (int i = 0; i < rippleVecSize; i++)
-    {
-        if(rippleIndexIsValid(i)){
-            ripple &current = rippleVector[i];
-            current.Tick(DeltaTime);
-            if (current.timeExceeded())
-            {
-                markedForRemoval.push_back(i);
-            }
-        }
-    }
-
-    for (int i = 0; i < markedForRemoval.size(); i++){
-        removeRippleAtIndex(markedForRemoval[i]);
-    }
+    rippleField.tick(DeltaTime);
 }
 
-void AcustomWaterActor::applyWaterRippleOffset(FVector &vertex, FVector &actorLocation){
-    float offsetSum = 0.0f;
-    for (int i = 0; i < rippleVecSize; i++)
-    {
-        if(rippleIndexIsValid(i)){
-            ripple &current = rippleVector[i];
-            current.changeHeightBasedOnDistance(vertex, actorLocation);
-        }
-    }
-}
-
-///@brief creates a new or reuses an old ripple object from the local object pool
+///@brief starts a new ripple from the fixed ripple pool
 void AcustomWaterActor::addNewRipple(FVector &location){
-    if(rippleVector.size() == 0 || rippleVecSize >= rippleVector.size()){
-        rippleVector.push_back(ripple(location, ownHalfSize)); //ownHalfSize for max radius
-        rippleVecSize = rippleVector.size();
-    }
-    
-    if(rippleVecSize < rippleVector.size()){
-        int last = rippleVecSize;
-        rippleVector[last].init(location, ownHalfSize * 0.5f); //reuse object
-        rippleVecSize++;
-    }
-
-}
-
-
-bool AcustomWaterActor::rippleIndexIsValid(int index){
-    return index >= 0 && index < rippleVecSize && index < rippleVector.size();
-}
-
-void AcustomWaterActor::removeRippleAtIndex(int index){
-    if(rippleVector.size() == 0){
-        rippleVecSize = 0;
-        return;
-    }
-
-    if(rippleIndexIsValid(index)){
-        int preLast = rippleVecSize - 1;
-        if(preLast == index){
-            rippleVecSize--;
-            return;
-        }
-
-        if(rippleIndexIsValid(preLast)){
-            //copy "back" to index and hide with seperate end pointer
-            rippleVector[index] = rippleVector[preLast];
-            rippleVecSize--;
-        }
-    }
+    rippleField.add(location, ownHalfSize); //ownHalfSize for max radius
 }
 
 
@@ -6,6 +6,8 @@
 #include "GameCore/MeshGenBase/customMeshActorBase.h"
 #include "GameCore/interfaces/DamageInterface.h"
 #include "ripple.h"
+#include "terrainPlugin/meshgen/water/RippleField.h"
+#include "terrainPlugin/meshgen/water/shader/WaveKernel.h"
 #include "customWaterActor.generated.h"
 
 /**
@@ -21,6 +23,7 @@ public:
 
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	virtual void takedamage(int d) override;
 	virtual void takedamage(int d, FVector &from) override;
@@ -55,6 +58,7 @@ protected:
 
 	int vertexcountX = 3;
 	int vertexcountY = 3;
+	int vertexDistance = DEFAULT_DISTANCE_BETWEEN_VERTECIES;
 
 	FVector BottomLeft;
 	FVector BottomRight;
@@ -83,6 +87,9 @@ protected:
 	void updateRunningTime(float deltaTime);
 	void vertexShader();
 	virtual void applyShaderToVertex(FVector &vertex) override;
+	virtual void applyShaderToBatch(VertexBatch &batch) override;
+	WaveKernel waveKernel;
+	float waveTime();
 	void resetAllShaderOffsets();
 	void resetVertexShadignFor(FVector &other);
 
@@ -90,19 +97,18 @@ protected:
 	bool playerIsInBounds();
 
 	bool meshInited = false;
+
+	//id in the WaterUpdateScheduler, -1 until the pane is created
+	int schedulerPaneId = -1;
 	
 
 	
 	//ripple section
 	float ownHalfSize = 100.0f;
 
-	int rippleVecSize = 0;
-	std::vector<ripple> rippleVector;
+	RippleField rippleField;
 	void TickRipples(float DeltaTime);
-	void applyWaterRippleOffset(FVector &vertex, FVector &actorLocation);
 	void addNewRipple(FVector &location);
-	bool rippleIndexIsValid(int index);
-	void removeRippleAtIndex(int index);
 
 
 	//helper for mesh
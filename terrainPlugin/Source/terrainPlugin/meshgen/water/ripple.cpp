@@ -26,6 +26,7 @@ ripple &ripple::operator=(const ripple &other){
     velocity = other.velocity;
     time = other.time;
     radius = other.radius;
+    maxRadius = other.maxRadius;
     impact = other.impact;
     waveHeight = other.waveHeight;
 
@@ -69,6 +70,12 @@ float ripple::waveHeightBasedOnTime(){
 ///@brief changes the vertex height based on distance to vertex+actor (combined)
 void ripple::changeHeightBasedOnDistance(FVector &vertex, FVector &offsetActor){
     float toCenter = FVector::Dist(vertex + offsetActor, impact);
+    vertex.Z += heightOffsetAt(toCenter);
+}
+
+/// @brief height offset of the ripple at a distance to its impact, 0 outside of the ring
+/// @param toCenter distance to the impact point
+float ripple::heightOffsetAt(float toCenter){
     if(toCenter > 0.01f){
 
         
@@ -80,11 +87,22 @@ void ripple::changeHeightBasedOnDistance(FVector &vertex, FVector &offsetActor){
         if (distFromRadius < rippleWidth)//range 50cm z.b.
         {
             float frac = 1.0f * cos(distFromRadius / rippleWidth);
-            float heightAdd = waveHeightBasedOnTime() * frac;
-            vertex.Z += heightAdd;
+            return waveHeightBasedOnTime() * frac;
         }
 
     }
+    return 0.0f;
+}
+
+FVector &ripple::impactPoint(){
+    return impact;
 }
 
+float ripple::currentRadius(){
+    return radius;
+}
 
+/// @brief half width of the moving ring, vertecies further away from the radius are untouched
+float ripple::influenceWidth(){
+    return rippleWidth;
+}
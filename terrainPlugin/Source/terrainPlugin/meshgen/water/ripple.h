@@ -24,10 +24,15 @@ public:
 	bool timeExceeded();
 
 	void changeHeightBasedOnDistance(FVector &vertex, FVector &offsetActor);
+	float heightOffsetAt(float toCenter);
 
-private:
+	FVector &impactPoint();
+	float currentRadius();
+	float influenceWidth();
 	float waveHeightBasedOnTime();
 
+private:
+
 	float maxlifeTime = 10.0f;
 	float velocity = 100.0f;
 	float time = 0.0f;
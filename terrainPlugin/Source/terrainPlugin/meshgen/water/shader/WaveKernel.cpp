@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WaveKernel.h"
+#include "Math/VectorRegister.h"
+#include <algorithm>
+#include <cmath>
+
+WaveKernel::WaveKernel()
+{
+}
+
+WaveKernel::~WaveKernel()
+{
+}
+
+/// @brief updates the phases for the current frame
+/// @param actorLocation world offset of the vertecies
+/// @param runningTime shader running time
+void WaveKernel::setup(
+    FVector &actorLocation,
+    float runningTime
+){
+    if(useTile){
+        if(tile == nullptr){
+            tile = WaveTile::instance();
+        }
+        tile->setupFrame(runningTime); //once per distinct time for all panes
+        tileOffsetX = (float)FMath::Fmod((double)actorLocation.X, (double)WaveTile::TILE_LENGTH);
+        tileOffsetY = (float)FMath::Fmod((double)actorLocation.Y, (double)WaveTile::TILE_LENGTH);
+        return;
+    }
+
+    //double precision for the large world offset, wrapped to one period
+    double timePhase = (double)runningTime * speed;
+    phaseX = (float)FMath::Fmod((double)actorLocation.X * frequency + timePhase, 2.0 * PI);
+    phaseY = (float)FMath::Fmod((double)actorLocation.Y * frequency + timePhase, 2.0 * PI);
+}
+
+/// @brief scalar version, same result as one simd lane
+float WaveKernel::evaluate(float x, float y){
+    if(useTile && tile != nullptr){
+        return tile->sampleHeight(x + tileOffsetX, y + tileOffsetY) * fadeAt(x, y);
+    }
+    float wave = FMath::Sin(x * frequency + phaseX) + FMath::Cos(y * frequency + phaseY);
+    return wave * amplitude * fadeAt(x, y);
+}
+
+/// @brief shortest wavelength in cm of the waves this kernel produces
+float WaveKernel::shortestWavelength(){
+    if(useTile){
+        if(tile == nullptr){
+            tile = WaveTile::instance();
+        }
+        return tile->shortestWavelength();
+    }
+    if(frequency <= 0.0f){
+        return 0.0f;
+    }
+    return 2.0f * PI / frequency;
+}
+
+/// @brief waves keep their height up to fullUntil and are faded to 0 at zeroFrom,
+/// distances in cm in local space of the vertecies
+/// @param fullUntil distance of full wave height
+/// @param zeroFrom distance from which the surface is flat, negative disables the fade
+void WaveKernel::setDistanceFade(float fullUntil, float zeroFrom){
+    fadeZeroFrom = zeroFrom;
+    fadeFullUntil = std::min(fullUntil, zeroFrom);
+}
+
+float WaveKernel::fadeAt(float x, float y){
+    if(fadeZeroFrom < 0.0f){
+        return 1.0f;
+    }
+    float distance = std::max(std::abs(x), std::abs(y));
+    if(distance >= fadeZeroFrom){
+        return 0.0f;
+    }
+    if(distance <= fadeFullUntil){
+        return 1.0f;
+    }
+    return (fadeZeroFrom - distance) / (fadeZeroFrom - fadeFullUntil);
+}
+
+void WaveKernel::applyDistanceFade(const float *xs, const float *ys, float *zs, int count){
+    if(fadeZeroFrom < 0.0f){
+        return;
+    }
+    for (int i = 0; i < count; i++){
+        zs[i] *= fadeAt(xs[i], ys[i]);
+    }
+}
+
+/// @brief processes all vertecies, count must be a multiple of 4, arrays 16 byte aligned
+/// (guaranteed by VertexBatch)
+void WaveKernel::process(const float *xs, const float *ys, float *zs, int count){
+    if(useTile && tile != nullptr){
+        for (int i = 0; i < count; i++){
+            zs[i] = tile->sampleHeight(xs[i] + tileOffsetX, ys[i] + tileOffsetY);
+        }
+        applyDistanceFade(xs, ys, zs, count);
+        return;
+    }
+
+    const VectorRegister4Float frequencyReg = VectorSetFloat1(frequency);
+    const VectorRegister4Float amplitudeReg = VectorSetFloat1(amplitude);
+    const VectorRegister4Float phaseXReg = VectorSetFloat1(phaseX);
+    const VectorRegister4Float phaseYReg = VectorSetFloat1(phaseY);
+
+    int i = 0;
+    for (; i + 3 < count; i += 4){
+        VectorRegister4Float x = VectorLoadAligned(xs + i);
+        VectorRegister4Float y = VectorLoadAligned(ys + i);
+
+        VectorRegister4Float argX = VectorMultiplyAdd(x, frequencyReg, phaseXReg);
+        VectorRegister4Float argY = VectorMultiplyAdd(y, frequencyReg, phaseYReg);
+
+        VectorRegister4Float wave = VectorAdd(VectorSin(argX), VectorCos(argY));
+        VectorStoreAligned(VectorMultiply(wave, amplitudeReg), zs + i);
+    }
+
+    //scalar tail, only if not padded, evaluate fades by itself
+    int vectorized = i;
+    for (; i < count; i++){
+        zs[i] = evaluate(xs[i], ys[i]);
+    }
+    applyDistanceFade(xs, ys, zs, vectorized);
+}
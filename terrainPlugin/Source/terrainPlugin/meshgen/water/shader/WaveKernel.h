@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "terrainPlugin/meshgen/water/shader/WaveTile.h"
+
+/**
+ * simd kernel for the water vertex shader, processes a VertexBatch 4 vertecies at once.
+ * z = (sin(x * f + phaseX) + cos(y * f + phaseY)) * amplitude
+ * The actor offset and the running time are folded into the phases, so the
+ * per vertex arguments stay small and float precision is kept far from the origin.
+ * With useTile the heights are looked up in the shared WaveTile instead, no trig per vertex,
+ * the actor offset is wrapped to the tile length for the same precision reason.
+ * An optional distance fade scales the waves down to 0 by the square distance
+ * max(|x|, |y|) of the local vertex, used where the vertex distance can not show them.
+ */
+class TERRAINPLUGIN_API WaveKernel
+{
+public:
+	WaveKernel();
+	~WaveKernel();
+
+	void setup(
+		FVector &actorLocation,
+		float runningTime
+	);
+
+	void process(const float *xs, const float *ys, float *zs, int count);
+
+	float evaluate(float x, float y);
+
+	float shortestWavelength();
+	void setDistanceFade(float fullUntil, float zeroFrom);
+
+	float frequency = 0.01f; // Wellenbreite
+	float amplitude = 10.0f; // Wellenhöhe
+	float speed = 1.0f; // Wellengeschwindigkeit
+
+	bool useTile = true;
+
+private:
+	float phaseX = 0.0f;
+	float phaseY = 0.0f;
+
+	WaveTile *tile = nullptr;
+	float tileOffsetX = 0.0f;
+	float tileOffsetY = 0.0f;
+
+	//distance fade, disabled while zeroFrom is negative
+	float fadeFullUntil = -1.0f;
+	float fadeZeroFrom = -1.0f;
+	float fadeAt(float x, float y);
+	void applyDistanceFade(const float *xs, const float *ys, float *zs, int count);
+};
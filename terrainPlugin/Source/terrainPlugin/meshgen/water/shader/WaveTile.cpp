@@ -0,0 +1,260 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WaveTile.h"
+#include "GameCore/DebugHelper.h"
+#include <cmath>
+#include <algorithm>
+
+WaveTile *WaveTile::instancePointer = nullptr;
+
+void WaveTile::EndGame(){
+    if(WaveTile *ptr = instancePointer){
+        delete ptr;
+        WaveTile::instancePointer = nullptr;
+    }
+}
+
+/// @brief you are not allowed to delete this pointer!
+/// @return instance pointer, baked with the default waves
+WaveTile *WaveTile::instance(){
+    if(WaveTile::instancePointer == nullptr){
+        WaveTile::instancePointer = new WaveTile();
+    }
+    return WaveTile::instancePointer;
+}
+
+/// @brief default waves match the old kernel:
+/// (sin(x * f + t) + cos(y * f + t)) * 10, f = 0.01 rounded to 10 cycles per tile
+WaveTile::WaveTile()
+{
+    addWave(10, 0, 1, 10.0f, 0.0f);
+    addWave(0, 10, 1, 10.0f, HALF_PI); //cos(a) = sin(a + pi/2)
+    bake();
+}
+
+WaveTile::~WaveTile()
+{
+    waves.clear();
+    heights.clear();
+    slopesX.clear();
+    slopesY.clear();
+}
+
+void WaveTile::clearWaves(){
+    waves.clear();
+    baked = false;
+}
+
+/// @brief adds a wave, cycles are full periods over the tile and over TIME_PERIOD,
+/// whole numbers keep the tile seamless. Call bake() afterwards.
+/// @param cyclesX periods along x over TILE_LENGTH
+/// @param cyclesY periods along y over TILE_LENGTH
+/// @param cyclesTime periods over TIME_PERIOD, defines the speed
+/// @param amplitude height in cm
+/// @param phase offset in radian
+void WaveTile::addWave(
+    int cyclesX,
+    int cyclesY,
+    int cyclesTime,
+    float amplitude,
+    float phase
+){
+    Wave wave;
+    wave.kx = 2.0f * PI * cyclesX / TILE_LENGTH;
+    wave.ky = 2.0f * PI * cyclesY / TILE_LENGTH;
+    wave.omega = 2.0f * PI * cyclesTime / TIME_PERIOD;
+    wave.amplitude = amplitude;
+    wave.phase = phase;
+    waves.push_back(wave);
+    baked = false;
+}
+
+bool WaveTile::isBaked(){
+    return baked;
+}
+
+int WaveTile::sampleIndex(int x, int y){
+    return x * RESOLUTION + y;
+}
+
+int WaveTile::wrap(int index){
+    index %= RESOLUTION;
+    if(index < 0){
+        index += RESOLUTION;
+    }
+    return index;
+}
+
+/// @brief bakes heights and slopes of all frames, only needed after changing the waves
+void WaveTile::bake(){
+    int layerSize = RESOLUTION * RESOLUTION;
+    heights.assign(layerSize * TIME_FRAMES, 0.0f);
+    slopesX.assign(layerSize * TIME_FRAMES, 0.0f);
+    slopesY.assign(layerSize * TIME_FRAMES, 0.0f);
+
+    double step = TILE_LENGTH / RESOLUTION;
+    double frameStep = TIME_PERIOD / TIME_FRAMES;
+    for (int frame = 0; frame < TIME_FRAMES; frame++){
+        double time = frame * frameStep;
+        int frameOffset = frame * layerSize;
+        for (int x = 0; x < RESOLUTION; x++){
+            for (int y = 0; y < RESOLUTION; y++){
+                double px = x * step;
+                double py = y * step;
+                double height = 0.0;
+                double slopeX = 0.0;
+                double slopeY = 0.0;
+                for (int i = 0; i < waves.size(); i++){
+                    Wave &wave = waves[i];
+                    double arg = wave.kx * px + wave.ky * py + wave.omega * time + wave.phase;
+                    height += wave.amplitude * std::sin(arg);
+                    double derivative = wave.amplitude * std::cos(arg);
+                    slopeX += derivative * wave.kx;
+                    slopeY += derivative * wave.ky;
+                }
+                int index = frameOffset + sampleIndex(x, y);
+                heights[index] = (float)height;
+                slopesX[index] = (float)slopeX;
+                slopesY[index] = (float)slopeY;
+            }
+        }
+    }
+
+    currentHeights.assign(layerSize, 0.0f);
+    currentSlopesX.assign(layerSize, 0.0f);
+    currentSlopesY.assign(layerSize, 0.0f);
+    currentTime = -1.0f;
+    baked = true;
+}
+
+/// @brief blends the two baked frames around the time into the current layer,
+/// called by every pane but only computed once per distinct time
+/// @param time any time in seconds, wrapped to TIME_PERIOD
+void WaveTile::setupFrame(float time){
+    if(!baked){
+        bake();
+    }
+    if(time == currentTime){
+        return;
+    }
+    currentTime = time;
+
+    double wrapped = std::fmod((double)time, (double)TIME_PERIOD);
+    if(wrapped < 0.0){
+        wrapped += TIME_PERIOD;
+    }
+    double framePosition = wrapped / TIME_PERIOD * TIME_FRAMES;
+    int frame0 = std::min((int)framePosition, TIME_FRAMES - 1);
+    int frame1 = (frame0 + 1) % TIME_FRAMES;
+    float frac = (float)(framePosition - frame0);
+
+    int layerSize = RESOLUTION * RESOLUTION;
+    int offset0 = frame0 * layerSize;
+    int offset1 = frame1 * layerSize;
+    for (int i = 0; i < layerSize; i++){
+        currentHeights[i] = FMath::Lerp(heights[offset0 + i], heights[offset1 + i], frac);
+        currentSlopesX[i] = FMath::Lerp(slopesX[offset0 + i], slopesX[offset1 + i], frac);
+        currentSlopesY[i] = FMath::Lerp(slopesY[offset0 + i], slopesY[offset1 + i], frac);
+    }
+}
+
+/// @brief finds the 4 samples around a position, positions wrap around the tile
+void WaveTile::bilinear(
+    float x,
+    float y,
+    int &x0,
+    int &y0,
+    int &x1,
+    int &y1,
+    float &fracX,
+    float &fracY
+){
+    float scale = RESOLUTION / TILE_LENGTH;
+    float u = x * scale;
+    float v = y * scale;
+    float floorU = std::floor(u);
+    float floorV = std::floor(v);
+    fracX = u - floorU;
+    fracY = v - floorV;
+    x0 = wrap((int)floorU);
+    y0 = wrap((int)floorV);
+    x1 = wrap(x0 + 1);
+    y1 = wrap(y0 + 1);
+}
+
+float WaveTile::sampleLayer(std::vector<float> &layer, float x, float y){
+    int x0, y0, x1, y1;
+    float fracX, fracY;
+    bilinear(x, y, x0, y0, x1, y1, fracX, fracY);
+
+    float bottom = FMath::Lerp(layer[sampleIndex(x0, y0)], layer[sampleIndex(x1, y0)], fracX);
+    float top = FMath::Lerp(layer[sampleIndex(x0, y1)], layer[sampleIndex(x1, y1)], fracX);
+    return FMath::Lerp(bottom, top, fracY);
+}
+
+/// @brief height of the current frame, x and y should be kept small (wrapped by the caller)
+/// for float precision, any value works because the tile repeats
+float WaveTile::sampleHeight(float x, float y){
+    return sampleLayer(currentHeights, x, y);
+}
+
+/// @brief normal of the current frame from the baked slopes
+FVector WaveTile::sampleNormal(float x, float y){
+    float slopeX = sampleLayer(currentSlopesX, x, y);
+    float slopeY = sampleLayer(currentSlopesY, x, y);
+    return FVector(-slopeX, -slopeY, 1.0f).GetSafeNormal();
+}
+
+/// @brief exact sum of all waves, reference for the baked tile
+float WaveTile::evaluateAnalytic(float x, float y, float time){
+    double height = 0.0;
+    for (int i = 0; i < waves.size(); i++){
+        Wave &wave = waves[i];
+        double arg = (double)wave.kx * x + (double)wave.ky * y + (double)wave.omega * time + wave.phase;
+        height += wave.amplitude * std::sin(arg);
+    }
+    return (float)height;
+}
+
+/// @brief wavelength of the wave with the most cycles over the tile in cm,
+/// a grid needs less than half of it as vertex distance to show the waves
+float WaveTile::shortestWavelength(){
+    float shortest = 0.0f;
+    for (int i = 0; i < waves.size(); i++){
+        float k = std::sqrt(waves[i].kx * waves[i].kx + waves[i].ky * waves[i].ky);
+        if(k <= 0.0f){
+            continue;
+        }
+        float wavelength = 2.0f * PI / k;
+        if(shortest <= 0.0f || wavelength < shortest){
+            shortest = wavelength;
+        }
+    }
+    return shortest;
+}
+
+/// @brief largest difference of sampleHeight to evaluateAnalytic. Linear interpolation
+/// along one axis is off by at most h^2 / 8 * max|f''|, over x, y and time the axis
+/// errors add up: sum of a * ((kx h)^2 + (ky h)^2 + (w dt)^2) / 8
+float WaveTile::interpolationErrorBound(){
+    float step = TILE_LENGTH / RESOLUTION;
+    float frameStep = TIME_PERIOD / TIME_FRAMES;
+    float bound = 0.0f;
+    for (int i = 0; i < waves.size(); i++){
+        Wave &wave = waves[i];
+        float phaseX = wave.kx * step;
+        float phaseY = wave.ky * step;
+        float phaseTime = wave.omega * frameStep;
+        bound += std::abs(wave.amplitude) *
+            (phaseX * phaseX + phaseY * phaseY + phaseTime * phaseTime) / 8.0f;
+    }
+    return bound;
+}
+
+float WaveTile::bakedHeight(int frame, int x, int y){
+    if(!baked || frame < 0 || frame >= TIME_FRAMES){
+        return 0.0f;
+    }
+    return heights[frame * RESOLUTION * RESOLUTION + sampleIndex(wrap(x), wrap(y))];
+}
@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <vector>
+
+/**
+ * precomputed periodic ocean height tile shared by all water panes.
+ * The tile is a sum of directional waves h = a * sin(k.xy + w * t + phase) where every
+ * wave does a whole number of cycles over TILE_LENGTH and TIME_PERIOD, so the tile
+ * repeats without seams in space and time. Heights and slopes are baked for
+ * TIME_FRAMES frames once, each frame the two nearest frames are blended into one
+ * current layer, panes only do a bilinear lookup per vertex, no trig.
+ */
+class TERRAINPLUGIN_API WaveTile
+{
+public:
+	static WaveTile *instance();
+	static void EndGame();
+	~WaveTile();
+
+	/// samples per axis, one sample every TILE_LENGTH / RESOLUTION cm
+	static const int RESOLUTION = 64;
+	static const int TIME_FRAMES = 32;
+	static constexpr float TILE_LENGTH = 6400.0f;
+	/// same period as AcustomMeshActorBase::TickShaderRunningTime
+	static constexpr float TIME_PERIOD = 2.0f * PI;
+
+	void clearWaves();
+	void addWave(
+		int cyclesX,
+		int cyclesY,
+		int cyclesTime,
+		float amplitude,
+		float phase
+	);
+	void bake();
+	bool isBaked();
+
+	void setupFrame(float time);
+
+	float sampleHeight(float x, float y);
+	FVector sampleNormal(float x, float y);
+
+	float evaluateAnalytic(float x, float y, float time);
+	float shortestWavelength();
+	float interpolationErrorBound();
+	float bakedHeight(int frame, int x, int y);
+
+private:
+	WaveTile();
+	static class WaveTile *instancePointer;
+
+	struct Wave{
+		float kx;
+		float ky;
+		float omega;
+		float amplitude;
+		float phase;
+	};
+	std::vector<Wave> waves;
+
+	bool baked = false;
+
+	//frame major: frame * RESOLUTION^2 + x * RESOLUTION + y
+	std::vector<float> heights;
+	std::vector<float> slopesX;
+	std::vector<float> slopesY;
+
+	float currentTime = -1.0f;
+	std::vector<float> currentHeights;
+	std::vector<float> currentSlopesX;
+	std::vector<float> currentSlopesY;
+
+	static int sampleIndex(int x, int y);
+	static int wrap(int index);
+	void bilinear(
+		float x,
+		float y,
+		int &x0,
+		int &y0,
+		int &x1,
+		int &y1,
+		float &fracX,
+		float &fracY
+	);
+	float sampleLayer(std::vector<float> &layer, float x, float y);
+};
@@ -42,7 +42,9 @@ public class terrainPlugin : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
-				"ProceduralMeshComponent"
+				"ProceduralMeshComponent",
+				"MeshDescription",
+				"StaticMeshDescription"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);